@@ -0,0 +1,637 @@
+/**
+ * @file bench_all.cpp
+ */
+
+#include <algorithm>   // for std::max
+#include <array>       // for std::array
+#include <chrono>      // for std::chrono
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::int64_t, std::uint64_t, std::uintmax_t
+#include <cstdio>      // for std::FILE, std::fopen, std::fclose
+#include <filesystem>  // for std::filesystem
+#include <fstream>     // for std::ofstream
+#include <functional>  // for std::function
+#include <ios>         // for std::ios
+#include <map>         // for std::map
+#include <memory>      // for std::unique_ptr
+#include <stdexcept>   // for std::runtime_error
+#include <string>      // for std::string, std::to_string
+#include <thread>      // for std::thread
+#include <utility>     // for std::pair
+#include <vector>      // for std::vector
+
+#include <benchmark/benchmark.h>
+
+#include "app.hpp"
+#include "core/args.hpp"
+#include "core/io.hpp"
+#include "core/string.hpp"
+#include "modules/analyze.hpp"
+
+#include "helpers.hpp"
+
+#define BENCHMARK_EXECUTABLE_NAME "benchmarks"
+
+namespace fixtures {
+
+/**
+ * @brief Create a line of code of exactly the requested length, by repeating a typical line.
+ *
+ * The line contains mixed case, a "std::" function and a trailing comment, so that every string function has work to do.
+ *
+ * @param length Number of characters in the line (e.g., "128").
+ *
+ * @return Line of code (e.g., "    std::vector<int> Values = {1, 2, 3};  // Trailing Comment    std::vec...").
+ */
+[[nodiscard]] std::string make_code_line(const std::size_t length)
+{
+    static constexpr const char *pattern = "    std::vector<int> Values = {1, 2, 3};  // Trailing Comment";
+    const std::string unit(pattern);
+    std::string line;
+    line.reserve(length + unit.size());
+    while (line.size() < length) {
+        line += unit;
+    }
+    line.resize(length);
+    return line;
+}
+
+/**
+ * @brief Convert a benchmark range argument to a size.
+ *
+ * @param state Benchmark state whose first range argument shall be converted.
+ *
+ * @return First range argument as a size (e.g., "128").
+ */
+[[nodiscard]] std::size_t get_size(const benchmark::State &state)
+{
+    return static_cast<std::size_t>(state.range(0));
+}
+
+/**
+ * @brief Derive a pseudo-random number from a seed, using the SplitMix64 finalizer.
+ *
+ * Unlike the standard distributions, the result is identical across standard library implementations, so the corpora are the same on every platform.
+ *
+ * @param seed Seed to derive the number from (e.g., "42").
+ *
+ * @return Pseudo-random number (e.g., "13679457532755275413").
+ */
+[[nodiscard]] std::uint64_t mix(std::uint64_t seed)
+{
+    seed += 0x9e3779b97f4a7c15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94d049bb133111ebULL;
+    return seed ^ (seed >> 31);
+}
+
+/**
+ * @brief Pick a line from a list of lines, deterministically based on a seed.
+ *
+ * @param lines Lines to pick from.
+ * @param seed Seed to pick the line with (e.g., "42").
+ *
+ * @return Picked line.
+ */
+template <std::size_t N>
+[[nodiscard]] const char *pick(const std::array<const char *, N> &lines,
+                               const std::uint64_t seed)
+{
+    return lines[static_cast<std::size_t>(mix(seed) % N)];
+}
+
+/**
+ * @brief Include directives with listed functions, as found at the top of a typical file.
+ */
+inline constexpr std::array<const char *, 8> include_lines = {
+    "#include <algorithm>  // for std::sort, std::find",
+    "#include <cstddef>    // for std::size_t",
+    "#include <iostream>   // for std::cout",
+    "#include <map>        // for std::map",
+    "#include <memory>     // for std::unique_ptr, std::make_unique",
+    "#include <string>     // for std::string, std::to_string",
+    "#include <vector>     // for std::vector",
+    "#include <fmt/core.h>",
+};
+
+/**
+ * @brief Lines of code that use a few standard functions each.
+ */
+inline constexpr std::array<const char *, 8> code_lines = {
+    "    std::vector<int> values = {3, 1, 2};",
+    "    std::sort(values.begin(), values.end());",
+    "    const std::size_t count = values.size();",
+    "    std::cout << std::to_string(count) << '\\n';",
+    "    auto owner = std::make_unique<std::string>(\"name\");",
+    "    if (std::find(values.cbegin(), values.cend(), 2) != values.cend()) {",
+    "    }",
+    "    return count;",
+};
+
+/**
+ * @brief Comment lines, both line comments and the inside of doxygen blocks.
+ */
+inline constexpr std::array<const char *, 6> comment_lines = {
+    "// Sort the values, so that std::find can be replaced with a binary search later",
+    "/**",
+    " * @brief Count the values that are not std::nullopt.",
+    " *",
+    " * @return Number of values (e.g., \"3\").",
+    " */",
+};
+
+/**
+ * @brief Lines of code that consist almost entirely of standard functions.
+ */
+inline constexpr std::array<const char *, 4> std_dense_lines = {
+    "    std::unordered_map<std::string, std::vector<std::pair<std::size_t, std::string>>> index;",
+    "    std::transform(std::begin(in), std::end(in), std::back_inserter(out), std::tolower);",
+    "    auto result = std::make_shared<std::optional<std::tuple<int, std::string>>>(std::nullopt);",
+    "    std::for_each(std::execution::par, std::cbegin(v), std::cend(v), std::function<void(int)>(f));",
+};
+
+/**
+ * @brief Class that represents a corpus of generated C++ files in a temporary directory.
+ *
+ * The files are generated once, on construction, and removed from disk on destruction.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Corpus final {
+  public:
+    /**
+     * @brief Construct a new Corpus object.
+     *
+     * @param name Name of the corpus, used as a suffix of the temporary directory (e.g., "comment_heavy").
+     * @param file_count Number of files to generate (e.g., "100").
+     * @param make_file Function that returns the contents of the file with the given index.
+     *
+     * @throws std::runtime_error If any file cannot be written.
+     */
+    explicit Corpus(const std::string &name,
+                    const std::size_t file_count,
+                    const std::function<std::string(std::size_t)> &make_file)
+        : temp_dir_(std::filesystem::temp_directory_path() / (BENCHMARK_EXECUTABLE_NAME "_" + name))
+    {
+        this->files_.reserve(file_count);
+        for (std::size_t i = 0; i < file_count; ++i) {
+            const std::string text = make_file(i);
+            const auto path = this->temp_dir_.get() / ("file_" + std::to_string(i) + ".cpp");
+            std::ofstream f(path, std::ios::binary);
+            if (!f || !(f << text)) {
+                throw std::runtime_error("Failed to write corpus file: " + path.string());
+            }
+            this->files_.emplace_back(path);
+            this->bytes_ += text.size();
+            for (const char c : text) {
+                if (c == '\n') {
+                    ++this->lines_;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get the temporary directory that holds the generated files.
+     *
+     * @return Const reference to the path (e.g., "/tmp/benchmarks_comment_heavy").
+     */
+    [[nodiscard]] const std::filesystem::path &get_directory() const
+    {
+        return this->temp_dir_.get();
+    }
+
+    /**
+     * @brief Get the paths to the generated files.
+     *
+     * @return Const reference to a vector of paths (e.g., {"/tmp/benchmarks_comment_heavy/file_0.cpp"}).
+     */
+    [[nodiscard]] const std::vector<std::filesystem::path> &get_files() const
+    {
+        return this->files_;
+    }
+
+    /**
+     * @brief Get the total size of the generated files.
+     *
+     * @return Number of bytes (e.g., "1048576").
+     */
+    [[nodiscard]] std::size_t get_bytes() const
+    {
+        return this->bytes_;
+    }
+
+    /**
+     * @brief Get the total number of lines of the generated files.
+     *
+     * @return Number of lines (e.g., "20000").
+     */
+    [[nodiscard]] std::size_t get_lines() const
+    {
+        return this->lines_;
+    }
+
+  private:
+    /**
+     * @brief Temporary directory that holds the generated files.
+     */
+    const helpers::TempDir temp_dir_;
+
+    /**
+     * @brief Paths to the generated files.
+     */
+    std::vector<std::filesystem::path> files_;
+
+    /**
+     * @brief Total size of the generated files in bytes.
+     */
+    std::size_t bytes_ = 0;
+
+    /**
+     * @brief Total number of lines of the generated files.
+     */
+    std::size_t lines_ = 0;
+};
+
+/**
+ * @brief Generate a file that starts with a block of include directives, followed by a mix of lines.
+ *
+ * @param seed Seed for the file (e.g., "42").
+ * @param include_count Number of include directives at the top (e.g., "8").
+ * @param line_count Number of lines after the include directives (e.g., "1000").
+ * @param make_line Function that returns the line for the given seed.
+ *
+ * @return Contents of the file, each line terminated by a newline.
+ */
+[[nodiscard]] std::string make_file(const std::uint64_t seed,
+                                    const std::size_t include_count,
+                                    const std::size_t line_count,
+                                    const std::function<std::string(std::uint64_t)> &make_line)
+{
+    std::string text;
+    for (std::size_t i = 0; i < include_count; ++i) {
+        text += pick(include_lines, seed + i);
+        text += '\n';
+    }
+    for (std::size_t i = 0; i < line_count; ++i) {
+        text += make_line(mix(seed) + i);
+        text += '\n';
+    }
+    return text;
+}
+
+/**
+ * @brief Get a corpus where most lines are comments, e.g., a heavily documented header.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &comment_heavy()
+{
+    static const Corpus corpus("comment_heavy", 20, [](const std::size_t i) {
+        return make_file(i, 8, 2000, [](const std::uint64_t seed) {
+            return std::string(mix(seed) % 5 != 0 ? pick(comment_lines, seed) : pick(code_lines, seed));
+        });
+    });
+    return corpus;
+}
+
+/**
+ * @brief Get a corpus where every line uses many standard functions.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &std_dense()
+{
+    static const Corpus corpus("std_dense", 20, [](const std::size_t i) {
+        return make_file(i, 8, 2000, [](const std::uint64_t seed) {
+            return std::string(pick(std_dense_lines, seed));
+        });
+    });
+    return corpus;
+}
+
+/**
+ * @brief Get a corpus where most lines are include directives, e.g., umbrella headers.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &include_heavy()
+{
+    static const Corpus corpus("include_heavy", 20, [](const std::size_t i) {
+        return make_file(i, 1500, 500, [](const std::uint64_t seed) {
+            return std::string(pick(code_lines, seed));
+        });
+    });
+    return corpus;
+}
+
+/**
+ * @brief Get a corpus of very long lines, e.g., generated tables or minified code.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &long_lines()
+{
+    static const Corpus corpus("long_lines", 10, [](const std::size_t i) {
+        return make_file(i, 8, 50, [](const std::uint64_t seed) {
+            std::string line;
+            for (std::uint64_t j = 0; line.size() < 8192; ++j) {
+                line += pick(code_lines, seed + j);
+            }
+            return line;
+        });
+    });
+    return corpus;
+}
+
+/**
+ * @brief Get a corpus of a single huge file with a typical mix of lines.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &huge_file()
+{
+    static const Corpus corpus("huge_file", 1, [](const std::size_t i) {
+        return make_file(i, 16, 200000, [](const std::uint64_t seed) {
+            return std::string(mix(seed) % 4 == 0 ? pick(comment_lines, seed) : pick(code_lines, seed));
+        });
+    });
+    return corpus;
+}
+
+/**
+ * @brief Get a corpus of many tiny files, where the per-file overhead dominates.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &many_tiny_files()
+{
+    static const Corpus corpus("many_tiny_files", 2000, [](const std::size_t i) {
+        return make_file(i, 3, 10, [](const std::uint64_t seed) {
+            return std::string(pick(code_lines, seed));
+        });
+    });
+    return corpus;
+}
+
+/**
+ * @brief Get a corpus with a typical mix of files of varying length, e.g., a mid-sized project.
+ *
+ * @return Const reference to the corpus, generated on first use.
+ */
+[[nodiscard]] const Corpus &application()
+{
+    static const Corpus corpus("application", 400, [](const std::size_t i) {
+        return make_file(i, 8, 50 + mix(i) % 400, [](const std::uint64_t seed) {
+            const std::uint64_t kind = mix(seed) % 8;
+            return std::string(kind < 2 ? pick(comment_lines, seed) : kind == 2 ? pick(std_dense_lines, seed) : pick(code_lines, seed));
+        });
+    });
+    return corpus;
+}
+
+}  // namespace fixtures
+
+namespace bench_string {
+
+void to_lower(benchmark::State &state)
+{
+    const std::string line = fixtures::make_code_line(fixtures::get_size(state));
+    for (auto _ : state) {
+        // Copy the line on every iteration, since "to_lower" takes it by value
+        benchmark::DoNotOptimize(core::string::to_lower(line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(line.size()));
+}
+
+void strip_whitespace(benchmark::State &state)
+{
+    // Pad the line with whitespace on both sides, a quarter of its length each
+    const std::size_t size = fixtures::get_size(state);
+    const std::string padding(size / 4, ' ');
+    const std::string line = padding + fixtures::make_code_line(size - 2 * padding.size()) + padding;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::string::strip_whitespace(line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(line.size()));
+}
+
+void remove_comment(benchmark::State &state)
+{
+    const std::string line = fixtures::make_code_line(fixtures::get_size(state));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::string::remove_comment(line));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(line.size()));
+}
+
+void create_cpp_reference_link(benchmark::State &state)
+{
+    // Function names are short in practice, so the range covers names from "std::" plus a few characters up to unusually long ones
+    const std::string name = "std::" + std::string(fixtures::get_size(state), 'x');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::string::create_cpp_reference_link(name));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(name.size()));
+}
+
+}  // namespace bench_string
+
+namespace bench_io {
+
+void read_lines(benchmark::State &state)
+{
+    // Create a temporary directory using RAII
+    const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / BENCHMARK_EXECUTABLE_NAME "_read_lines");
+
+    // Write a file with the requested number of typical lines
+    const std::size_t line_count = fixtures::get_size(state);
+    const auto temp_file = temp_dir.get() / "read_lines.cpp";
+    std::size_t byte_count = 0;
+    {
+        std::ofstream f(temp_file);
+        if (!f) {
+            throw std::runtime_error("Failed to open temp_file for writing");
+        }
+        const std::string line = fixtures::make_code_line(64);
+        for (std::size_t i = 0; i < line_count; ++i) {
+            f << line << '\n';
+        }
+        byte_count = line_count * (line.size() + 1);
+    }
+
+    for (auto _ : state) {
+        // The vector is destroyed inside the timed region, since every caller pays for the deallocation too
+        const auto lines = core::io::read_lines(temp_file);
+        benchmark::DoNotOptimize(lines.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(byte_count));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(line_count));
+}
+
+}  // namespace bench_io
+
+namespace bench_analyze {
+
+void parse(benchmark::State &state,
+           const fixtures::Corpus &(*get_corpus)())
+{
+    // Generate the corpus outside of the timed region
+    const fixtures::Corpus &corpus = get_corpus();
+    for (auto _ : state) {
+        for (const auto &file : corpus.get_files()) {
+            const modules::analyze::CodeParser parser(file);
+            benchmark::DoNotOptimize(parser.get_unlisted_functions().get_functions().data());
+        }
+    }
+    const auto iterations = static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.get_bytes()));
+    state.counters["lines_per_second"] = benchmark::Counter(iterations * static_cast<double>(corpus.get_lines()), benchmark::Counter::kIsRate);
+    state.counters["files_per_second"] = benchmark::Counter(iterations * static_cast<double>(corpus.get_files().size()), benchmark::Counter::kIsRate);
+}
+
+void parse_contended(benchmark::State &state,
+                     const fixtures::Corpus &(*get_corpus)())
+{
+    // Each thread parses its own share of the files, so the threads only share the global allocator and the static tables
+    const fixtures::Corpus &corpus = get_corpus();
+    const auto thread_index = static_cast<std::size_t>(state.thread_index());
+    const auto thread_count = static_cast<std::size_t>(state.threads());
+    std::vector<std::filesystem::path> share;
+    std::uintmax_t share_bytes = 0;
+    for (std::size_t i = thread_index; i < corpus.get_files().size(); i += thread_count) {
+        share.emplace_back(corpus.get_files()[i]);
+        share_bytes += std::filesystem::file_size(share.back());
+    }
+    for (auto _ : state) {
+        for (const auto &file : share) {
+            const modules::analyze::CodeParser parser(file);
+            benchmark::DoNotOptimize(parser.get_unlisted_functions().get_functions().data());
+        }
+    }
+    // The counters of all threads are summed, so these are the totals of the whole run
+    const auto iterations = static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(share_bytes));
+    state.counters["files_per_second"] = benchmark::Counter(iterations * static_cast<double>(share.size()), benchmark::Counter::kIsRate);
+}
+
+}  // namespace bench_analyze
+
+namespace bench_app {
+
+/**
+ * @brief Wall time per iteration of the single-threaded case, with and without the report, used as the reference for speedup and efficiency.
+ */
+std::map<bool, double> single_thread_seconds;
+
+void run(benchmark::State &state,
+         const bool report)
+{
+    // Generate the corpus outside of the timed region
+    const fixtures::Corpus &corpus = fixtures::application();
+    const std::size_t threads = fixtures::get_size(state);
+
+    // The arguments are parsed on every iteration, since traversing the corpus is part of the pipeline
+    std::vector<std::string> arguments = {BENCHMARK_EXECUTABLE_NAME, corpus.get_directory().string(), "--threads", std::to_string(threads)};
+    if (!report) {
+        arguments.emplace_back("--no-report");
+    }
+    std::vector<char *> argv;
+    for (auto &argument : arguments) {
+        argv.emplace_back(argument.data());
+    }
+
+    // Render into a null sink, so that the terminal does not limit the throughput, but formatting and the output lock are still paid for
+#if defined(_WIN32)
+    const std::unique_ptr<std::FILE, int (*)(std::FILE *)> sink(std::fopen("NUL", "w"), std::fclose);
+#else
+    const std::unique_ptr<std::FILE, int (*)(std::FILE *)> sink(std::fopen("/dev/null", "w"), std::fclose);
+#endif
+    if (!sink) {
+        throw std::runtime_error("Failed to open the null device for writing");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        const core::args::Args args(static_cast<int>(argv.size()), argv.data());
+        app::run(args, sink.get());
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The single-threaded case is registered first, so the other cases can be compared against it
+    const double seconds = elapsed / std::max(static_cast<double>(state.iterations()), 1.0);
+    if (threads == 1) {
+        single_thread_seconds[report] = seconds;
+    }
+    if (const auto it = single_thread_seconds.find(report); it != single_thread_seconds.cend() && seconds > 0.0) {
+        const double speedup = it->second / seconds;
+        state.counters["speedup"] = speedup;
+        state.counters["efficiency"] = speedup / static_cast<double>(threads);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(corpus.get_bytes()));
+    state.counters["files_per_second"] = benchmark::Counter(static_cast<double>(state.iterations()) * static_cast<double>(corpus.get_files().size()), benchmark::Counter::kIsRate);
+}
+
+}  // namespace bench_app
+
+// Line lengths: 16 is a short statement, 64 a typical line, 4096 a generated or minified one
+BENCHMARK(bench_string::to_lower)->RangeMultiplier(8)->Range(16, 4096);
+BENCHMARK(bench_string::strip_whitespace)->RangeMultiplier(8)->Range(16, 4096);
+BENCHMARK(bench_string::remove_comment)->RangeMultiplier(8)->Range(16, 4096);
+BENCHMARK(bench_string::create_cpp_reference_link)->RangeMultiplier(4)->Range(4, 256);
+
+// Line counts: from a small header to a very large source file
+BENCHMARK(bench_io::read_lines)->RangeMultiplier(8)->Range(64, 1 << 15)->Unit(benchmark::kMicrosecond);
+
+// Corpora: each one stresses a different part of the parser, see the fixtures for their shapes
+// "BENCHMARK_CAPTURE" cannot take a qualified function name, so the cases are registered manually, keeping the "namespace::function/case" naming
+[[maybe_unused]] static const bool bench_analyze_registered = [] {
+    const std::array<std::pair<const char *, const fixtures::Corpus &(*)()>, 6> corpora = {{
+        {"comment_heavy", &fixtures::comment_heavy},
+        {"std_dense", &fixtures::std_dense},
+        {"include_heavy", &fixtures::include_heavy},
+        {"long_lines", &fixtures::long_lines},
+        {"huge_file", &fixtures::huge_file},
+        {"many_tiny_files", &fixtures::many_tiny_files},
+    }};
+    for (const auto &[name, get_corpus] : corpora) {
+        benchmark::RegisterBenchmark((std::string("bench_analyze::parse/") + name).c_str(), bench_analyze::parse, get_corpus)->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}();
+
+// Thread counts: from one thread up to the number of hardware threads, on the corpora with the most temporaries per byte
+// The parser's temporaries live in a per-thread arena, so the throughput per thread should hold up instead of contending for the global allocator
+[[maybe_unused]] static const bool bench_analyze_contended_registered = [] {
+    const int hardware_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    const std::array<std::pair<const char *, const fixtures::Corpus &(*)()>, 2> corpora = {{
+        {"std_dense", &fixtures::std_dense},
+        {"many_tiny_files", &fixtures::many_tiny_files},
+    }};
+    for (const auto &[name, get_corpus] : corpora) {
+        benchmark::RegisterBenchmark((std::string("bench_analyze::parse_contended/") + name).c_str(), bench_analyze::parse_contended, get_corpus)
+            ->ThreadRange(1, hardware_threads)
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}();
+
+// Thread counts: powers of two up to the number of hardware threads, and the number of hardware threads itself
+// Without the report, nothing is formatted or printed, so the difference between the two cases is the cost of rendering and of the output lock
+[[maybe_unused]] static const bool bench_app_registered = [] {
+    const std::size_t hardware_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<std::int64_t> thread_counts;
+    for (std::size_t threads = 1; threads < hardware_threads; threads *= 2) {
+        thread_counts.emplace_back(static_cast<std::int64_t>(threads));
+    }
+    thread_counts.emplace_back(static_cast<std::int64_t>(hardware_threads));
+    for (const bool report : {true, false}) {
+        auto *const bench = benchmark::RegisterBenchmark(report ? "bench_app::run/report" : "bench_app::run/no_report", bench_app::run, report);
+        bench->ArgName("threads")->UseRealTime()->Unit(benchmark::kMillisecond);
+        for (const auto threads : thread_counts) {
+            bench->Arg(threads);
+        }
+    }
+    return true;
+}();
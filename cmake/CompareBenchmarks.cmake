@@ -0,0 +1,153 @@
+# Run the throughput benchmarks and compare them against a committed baseline, failing on regressions
+#
+# Usage:
+#   cmake -DBENCHMARK_EXECUTABLE=<path> -DBASELINE=<path> -DOUTPUT=<path> [-DTOLERANCE_PERCENT=20] [-DREPETITIONS=5] [-DUPDATE=ON] -P CompareBenchmarks.cmake
+#
+# Only the benchmarks that guard the hot path are compared, i.e., "bench_analyze::parse" (CodeParser) and "bench_io::read_lines".
+# Each benchmark is repeated, and the median of its bytes per second is compared, since it is less sensitive to noise than the mean.
+# With UPDATE=ON, the baseline is overwritten with the current results instead, e.g., after an intended slowdown or on a new reference machine.
+
+# JSON parsing requires CMake 3.19, this also enables the policies of that version when run as a script
+cmake_minimum_required(VERSION 3.19)
+
+foreach(variable BENCHMARK_EXECUTABLE BASELINE OUTPUT)
+  if(NOT DEFINED ${variable})
+    message(FATAL_ERROR "Variable '${variable}' is not set. Cannot compare benchmarks.")
+  endif()
+endforeach()
+if(NOT DEFINED TOLERANCE_PERCENT)
+  set(TOLERANCE_PERCENT 20)
+endif()
+if(NOT DEFINED REPETITIONS)
+  set(REPETITIONS 5)
+endif()
+
+# Convert a JSON number (e.g., "1.2345e+08") to an integer, since CMake can only do integer math
+function(json_number_to_integer value out)
+  if(NOT value MATCHES "^([0-9]+)(\\.([0-9]+))?([eE]([+-]?[0-9]+))?$")
+    message(FATAL_ERROR "Cannot convert '${value}' to an integer.")
+  endif()
+  set(digits "${CMAKE_MATCH_1}${CMAKE_MATCH_3}")
+  string(LENGTH "${CMAKE_MATCH_3}" fraction_length)
+  set(exponent 0)
+  if(CMAKE_MATCH_5)
+    set(exponent ${CMAKE_MATCH_5})
+  endif()
+  # Shift the decimal point to the end of the digits, then pad with zeros or truncate
+  math(EXPR shift "${exponent} - ${fraction_length}")
+  if(shift GREATER_EQUAL 0)
+    string(REPEAT "0" ${shift} zeros)
+    string(APPEND digits "${zeros}")
+  else()
+    string(LENGTH "${digits}" digit_count)
+    math(EXPR keep "${digit_count} + ${shift}")
+    if(keep LESS_EQUAL 0)
+      set(digits "0")
+    else()
+      string(SUBSTRING "${digits}" 0 ${keep} digits)
+    endif()
+  endif()
+  # Strip leading zeros, so that "math" does not read the number as octal
+  string(REGEX REPLACE "^0+([0-9])" "\\1" digits "${digits}")
+  set(${out} ${digits} PARENT_SCOPE)
+endfunction()
+
+# Read the median bytes per second of each benchmark from a Google Benchmark JSON file, as a list of "name=value" pairs
+function(read_throughput path out)
+  file(READ "${path}" json)
+  string(JSON count LENGTH "${json}" benchmarks)
+  set(pairs "")
+  if(count GREATER 0)
+    math(EXPR last "${count} - 1")
+    foreach(i RANGE ${last})
+      string(JSON entry GET "${json}" benchmarks ${i})
+      # The baseline only stores the medians, the raw output also contains the other aggregates
+      string(JSON run_type ERROR_VARIABLE ignored GET "${entry}" run_type)
+      string(JSON aggregate ERROR_VARIABLE ignored GET "${entry}" aggregate_name)
+      if(run_type STREQUAL "aggregate" AND NOT aggregate STREQUAL "median")
+        continue()
+      endif()
+      string(JSON name GET "${entry}" run_name)
+      string(JSON bytes_per_second GET "${entry}" bytes_per_second)
+      json_number_to_integer("${bytes_per_second}" bytes_per_second)
+      list(APPEND pairs "${name}=${bytes_per_second}")
+    endforeach()
+  endif()
+  set(${out} "${pairs}" PARENT_SCOPE)
+endfunction()
+
+# Run the benchmarks, the raw results are kept for inspection
+execute_process(
+  COMMAND "${BENCHMARK_EXECUTABLE}"
+          "--benchmark_filter=^bench_(analyze::parse|io::read_lines)/"
+          "--benchmark_repetitions=${REPETITIONS}"
+          "--benchmark_report_aggregates_only=true"
+          "--benchmark_out=${OUTPUT}"
+          "--benchmark_out_format=json"
+  RESULT_VARIABLE result
+  OUTPUT_VARIABLE output
+  ERROR_VARIABLE output
+)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Benchmarks failed with '${result}':\n${output}")
+endif()
+read_throughput("${OUTPUT}" current)
+
+# Write the medians to the baseline, without the other aggregates, so that the diff of an update stays small
+if(UPDATE)
+  file(READ "${OUTPUT}" raw)
+  string(JSON context GET "${raw}" context)
+  set(baseline "{\"context\": {}, \"benchmarks\": []}")
+  foreach(key host_name num_cpus mhz_per_cpu library_build_type)
+    string(JSON value ERROR_VARIABLE ignored GET "${context}" ${key})
+    if(value)
+      string(JSON baseline SET "${baseline}" context ${key} "\"${value}\"")
+    endif()
+  endforeach()
+  set(i 0)
+  foreach(pair IN LISTS current)
+    string(REGEX MATCH "^(.*)=([0-9]+)$" ignored "${pair}")
+    string(JSON baseline SET "${baseline}" benchmarks ${i} "{\"run_name\": \"${CMAKE_MATCH_1}\", \"bytes_per_second\": ${CMAKE_MATCH_2}}")
+    math(EXPR i "${i} + 1")
+  endforeach()
+  file(WRITE "${BASELINE}" "${baseline}\n")
+  message(STATUS "Baseline updated with ${i} benchmarks: ${BASELINE}")
+  return()
+endif()
+
+# Compare each benchmark of the baseline, a benchmark that is missing now counts as a regression too
+read_throughput("${BASELINE}" expected)
+math(EXPR threshold "100 - ${TOLERANCE_PERCENT}")
+set(regressions "")
+foreach(pair IN LISTS expected)
+  string(REGEX MATCH "^(.*)=([0-9]+)$" ignored "${pair}")
+  set(name "${CMAKE_MATCH_1}")
+  set(baseline_value "${CMAKE_MATCH_2}")
+  set(current_value "")
+  foreach(candidate IN LISTS current)
+    if(candidate MATCHES "^(.*)=([0-9]+)$" AND CMAKE_MATCH_1 STREQUAL name)
+      set(current_value "${CMAKE_MATCH_2}")
+    endif()
+  endforeach()
+  if(current_value STREQUAL "")
+    list(APPEND regressions "${name}: missing")
+    continue()
+  endif()
+  # Compare in kilobytes per second, so that the percentages cannot overflow
+  math(EXPR baseline_kb "${baseline_value} / 1000")
+  math(EXPR current_kb "${current_value} / 1000")
+  if(baseline_kb EQUAL 0)
+    set(baseline_kb 1)
+  endif()
+  math(EXPR percent "${current_kb} * 100 / ${baseline_kb}")
+  message(STATUS "${name}: ${current_kb} KB/s, ${percent}% of the baseline (${baseline_kb} KB/s)")
+  if(percent LESS threshold)
+    list(APPEND regressions "${name}: ${percent}% of the baseline")
+  endif()
+endforeach()
+
+if(regressions)
+  list(JOIN regressions "\n  " details)
+  message(FATAL_ERROR "Throughput dropped by more than ${TOLERANCE_PERCENT}%:\n  ${details}")
+endif()
+message(STATUS "No benchmark dropped by more than ${TOLERANCE_PERCENT}%.")
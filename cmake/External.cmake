@@ -45,3 +45,36 @@ function(fetch_and_link_external_dependencies target)
 
   message(STATUS "Linked dependencies 'argparse', 'fmt', and 'thread_pool' to target '${target}'.")
 endfunction()
+
+function(fetch_and_link_benchmark_dependencies target)
+  if(NOT TARGET ${target})
+    message(FATAL_ERROR "Target '${target}' does not exist. Cannot fetch and link benchmark dependencies.")
+  endif()
+
+  set(FETCHCONTENT_UPDATES_DISCONNECTED ON)
+  set(FETCHCONTENT_QUIET OFF)
+  set(FETCHCONTENT_BASE_DIR "${CMAKE_SOURCE_DIR}/deps")
+
+  # Only the library is needed, so skip its own tests, which would otherwise require GoogleTest
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_WERROR OFF CACHE BOOL "" FORCE)
+
+  # SYSTEM is used to prevent applying compile flags to the dependencies
+  FetchContent_Declare(
+    benchmark
+    URL https://github.com/google/benchmark/archive/refs/tags/v1.9.1.zip
+    DOWNLOAD_EXTRACT_TIMESTAMP TRUE
+    EXCLUDE_FROM_ALL
+    SYSTEM
+  )
+
+  # Make dependencies available
+  FetchContent_MakeAvailable(benchmark)
+
+  # Link dependencies to the target, "benchmark_main" provides the main function
+  target_link_libraries(${target} PRIVATE benchmark::benchmark benchmark::benchmark_main)
+
+  message(STATUS "Linked dependency 'benchmark' to target '${target}'.")
+endfunction()
@@ -2,134 +2,696 @@
  * @file app.cpp
  */
 
-#include <filesystem>  // for std::filesystem
-#include <sstream>     // for std::ostringstream
+#include <algorithm>           // for std::max, std::min
+#include <chrono>              // for std::chrono
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for std::size_t
+#include <cstdio>              // for std::FILE, stderr, stdout
+#include <filesystem>          // for std::filesystem
+#include <iterator>            // for std::back_inserter
+#include <map>                 // for std::map
+#include <memory>              // for std::unique_ptr, std::make_unique
+#include <mutex>               // for std::mutex, std::unique_lock, std::defer_lock, std::lock_guard
+#include <optional>            // for std::optional, std::nullopt
+#include <ratio>               // for std::milli
+#include <set>                 // for std::set
+#include <string>              // for std::string
+#include <string_view>         // for std::string_view
+#include <unordered_set>       // for std::unordered_set
+#include <utility>             // for std::in_place, std::move
+#include <vector>              // for std::vector
 
 #include <BS_thread_pool.hpp>
-#include <BS_thread_pool_utils.hpp>
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
 #include "app.hpp"
 #include "core/args.hpp"
+#include "core/channel.hpp"
+#include "core/perf.hpp"
+#include "core/stats.hpp"
+#include "core/stdlib.hpp"
 #include "core/string.hpp"
+#include "core/trace.hpp"
+#include "modules/aggregate.hpp"
 #include "modules/analyze.hpp"
+#include "modules/fix.hpp"
+#include "modules/graph.hpp"
+#include "modules/index.hpp"
 
 namespace app {
 
-void run(const core::args::Args &args)
+namespace {
+
+/**
+ * @brief Number of files per worker thread that the traversal may get ahead of the analysis, so that a worker never waits for the next file.
+ */
+constexpr std::size_t files_per_worker = 16;
+
+/**
+ * @brief Struct that represents a file handed from the traversal to a worker thread.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct QueuedFile final {
+    /**
+     * @brief Position of the file in the traversal, starting at 0 (e.g., "3").
+     */
+    std::size_t index;
+
+    /**
+     * @brief Path to the file (e.g., "~/main.cpp").
+     */
+    std::filesystem::path path;
+};
+
+/**
+ * @brief Private helper function to call a function for each file produced by a traversal, either sequentially or in a thread pool.
+ *
+ * With a thread pool, the calling thread walks the files into a bounded channel, and each worker thread takes the next file as soon as it is done with the previous one. Only the files in the channel are held at once, so the memory does not grow with the number of files.
+ *
+ * @param next Function that returns the next file, or std::nullopt once all files have been produced (e.g., "[&walker]() { return walker.next(); }").
+ * @param pool Thread pool to consume the files in, or nullptr to process the files sequentially on the calling thread.
+ * @param function Function that takes the position and path of a file (e.g., "[](std::size_t i, const std::filesystem::path &path) {...}").
+ *
+ * @return Number of files produced.
+ *
+ * @throws Any exception thrown by the traversal or by the function, rethrown after all tasks have completed.
+ */
+template <typename Next, typename Function>
+std::size_t for_each_file(const Next &next,
+                          BS::thread_pool *pool,
+                          const Function &function)
 {
-    fmt::print("Analyzing {} files: [{}]\n\n",
-               args.filepaths.size(),
-               fmt::join(core::string::paths_to_strings(args.filepaths), ", "));
-    // fmt::print("Enabled: bare={}, unused={}, unlisted={}, multithreading={}\n\n\n",
-    //            args.enable.bare, args.enable.unused, args.enable.unlisted, args.enable.multithreading);
+    std::size_t count = 0;
+    if (pool == nullptr) {
+        while (const auto path = next()) {
+            function(count++, *path);
+        }
+        return count;
+    }
+
+    // Start one consumer per worker thread, a failed consumer closes the channel, so that the traversal does not wait for it
+    const std::size_t worker_count = static_cast<std::size_t>(pool->get_thread_count());
+    core::channel::Channel<QueuedFile> channel(worker_count * files_per_worker);
+    BS::multi_future<void> futures;
+    futures.reserve(worker_count);
+    for (std::size_t i = 0; i < worker_count; ++i) {
+        futures.emplace_back(pool->submit_task([&channel, &function]() {
+            try {
+                while (const auto file = channel.pop()) {
+                    function(file->index, file->path);
+                }
+            }
+            catch (...) {
+                channel.close();
+                throw;
+            }
+        }));
+    }
+
+    // Produce the files on the calling thread, waiting whenever the workers fall behind
+    try {
+        while (auto path = next()) {
+            if (!channel.push(QueuedFile{count, std::move(*path)})) {
+                break;
+            }
+            ++count;
+        }
+    }
+    catch (...) {
+        // Let the workers drain the channel before rethrowing, since they refer to it
+        channel.close();
+        futures.wait();
+        throw;
+    }
+
+    // Wait for all tasks to complete and rethrow exceptions
+    channel.close();
+    futures.get();
+    return count;
+}
+
+/**
+ * @brief Class that prints the diffs of the files in file order, although the worker threads finish the files out of order.
+ *
+ * A diff that finishes early is held until the diffs of all earlier files have been printed. At most "capacity" diffs are held at once: a thread whose file is that far ahead of the printed diffs waits, so that one slow file cannot make the other threads buffer the diffs of all files after it.
+ *
+ * @note This class is marked as `final` to prevent inheritance. The thread with the oldest unprinted file never waits, since the files are handed out in order.
+ */
+class DiffPrinter final {
+  public:
+    /**
+     * @brief Construct a new DiffPrinter object.
+     *
+     * @param out Stream to print to (e.g., "stdout").
+     * @param capacity Maximum number of diffs held at once, at least 1 (e.g., "64").
+     */
+    explicit DiffPrinter(std::FILE *out,
+                         const std::size_t capacity)
+        : out_(out),
+          capacity_(capacity == 0 ? 1 : capacity) {}
+
+    /**
+     * @brief Print the diff of a file and any held diffs that follow it, or hold the diff until the diffs of all earlier files have been printed.
+     *
+     * @param index Position of the file in the traversal, starting at 0 (e.g., "3").
+     * @param diff Rendered diff, empty if the file has no changes.
+     */
+    void print(const std::size_t index,
+               std::string diff)
+    {
+        std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+        {
+            const core::trace::ScopedSpan wait_span("wait-for-output-lock");
+            lock.lock();
+            printed_.wait(lock, [this, index] { return aborted_ || index < next_ + capacity_; });
+        }
+        if (aborted_) {
+            return;
+        }
+        const core::trace::ScopedSpan write_span("write");
+        pending_.emplace(index, std::move(diff));
+        for (auto it = pending_.begin(); it != pending_.end() && it->first == next_; it = pending_.erase(it)) {
+            fmt::print(out_, "{}", it->second);
+            ++next_;
+        }
+        lock.unlock();
+        printed_.notify_all();
+    }
+
+    /**
+     * @brief Stop printing, e.g., because a file failed and its diff will never arrive, waking up all waiting threads.
+     *
+     * The held diffs and any diffs passed later are dropped.
+     */
+    void abort()
+    {
+        {
+            const std::unique_lock<std::mutex> lock(mutex_);
+            aborted_ = true;
+        }
+        printed_.notify_all();
+    }
+
+  private:
+    /**
+     * @brief Stream to print to.
+     */
+    std::FILE *const out_;
 
-    fmt::print("--------------------------------------------------------------------------------\n\n");
+    /**
+     * @brief Maximum number of diffs held at once.
+     */
+    const std::size_t capacity_;
 
-    // Create a synced stream for thread-safe printing
-    BS::synced_stream sync_out;
+    /**
+     * @brief Mutex that protects the members below.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @brief Signalled when diffs are printed or printing is aborted.
+     */
+    std::condition_variable printed_;
+
+    /**
+     * @brief Diffs that wait for an earlier diff, keyed by the position of their file.
+     */
+    std::map<std::size_t, std::string> pending_;
+
+    /**
+     * @brief Position of the file whose diff is printed next.
+     */
+    std::size_t next_ = 0;
+
+    /**
+     * @brief If true, printing was aborted.
+     */
+    bool aborted_ = false;
+};
+
+/**
+ * @brief Private helper function to print the statistics collected during the run.
+ *
+ * @param out Stream to print to (e.g., "stdout").
+ * @param analysis Wall time of the analysis, i.e., from the first to the last processed file, including the traversal that overlaps it.
+ * @param run Wall time of the run after the arguments were parsed.
+ * @param setup Time spent in the traversal while parsing the arguments (e.g., reading a compilation database), added to the run for the total.
+ */
+void print_stats(std::FILE *out,
+                 const std::chrono::nanoseconds analysis,
+                 const std::chrono::nanoseconds run,
+                 const std::chrono::nanoseconds setup)
+{
+    using milliseconds = std::chrono::duration<double, std::milli>;
+    using seconds = std::chrono::duration<double>;
+
+    const auto summary = core::stats::collect();
+    const auto traverse = summary.phases[static_cast<std::size_t>(core::stats::Phase::Traverse)];
+    // Avoid dividing by zero for empty or extremely fast runs
+    const double analysis_seconds = std::max(seconds(analysis).count(), 1e-9);
+    const double megabytes = static_cast<double>(summary.bytes) / 1e6;
+
+    fmt::print(out, "-- STATS --\n\n");
+    fmt::print(out, "Wall time: {:.2f} ms traversal, {:.2f} ms analysis, {:.2f} ms total\n",
+               milliseconds(traverse).count(), milliseconds(analysis).count(), milliseconds(setup + run).count());
+    fmt::print(out, "Throughput: {} files, {:.2f} MB read, {:.2f} files/s, {:.2f} MB/s\n\n",
+               summary.files, megabytes, static_cast<double>(summary.files) / analysis_seconds, megabytes / analysis_seconds);
+
+    // Phases overlap across threads, so their share is relative to the sum of all phases
+    std::chrono::nanoseconds phase_total{0};
+    for (const auto &phase : summary.phases) {
+        phase_total += phase;
+    }
+    // The parse phase is entered once per parsed file, so a file that is parsed twice shows up as more entries than files
+    fmt::print(out, "Time per phase, summed over all threads:\n");
+    for (std::size_t i = 0; i < core::stats::phase_count; ++i) {
+        const double share = phase_total.count() == 0 ? 0.0 : 100.0 * static_cast<double>(summary.phases[i].count()) / static_cast<double>(phase_total.count());
+        fmt::print(out, "{}: {:.2f} ms ({:.1f}%), entered {} times\n", core::stats::get_phase_name(static_cast<core::stats::Phase>(i)), milliseconds(summary.phases[i]).count(), share, summary.entries[i]);
+    }
+
+    // Idle time is the part of the analysis a thread did not spend on files, e.g., waiting for tasks
+    fmt::print(out, "\nBusy time per thread:\n");
+    for (std::size_t i = 0; i < summary.busy.size(); ++i) {
+        const auto idle = std::max(analysis - summary.busy[i], std::chrono::nanoseconds{0});
+        fmt::print(out, "thread {}: {:.2f} ms busy, {:.2f} ms idle ({:.1f}% busy)\n",
+                   i + 1, milliseconds(summary.busy[i]).count(), milliseconds(idle).count(),
+                   100.0 * std::min(seconds(summary.busy[i]).count() / analysis_seconds, 1.0));
+    }
+
+    // Percentiles show the tail that the averages above hide, the slowest file is also the one responsible for the maximum
+    if (summary.latency.get_count() != 0) {
+        fmt::print(out, "\nLatency per file: p50 {:.2f} ms, p90 {:.2f} ms, p99 {:.2f} ms, p99.9 {:.2f} ms, max {:.2f} ms",
+                   milliseconds(summary.latency.get_percentile(50.0)).count(), milliseconds(summary.latency.get_percentile(90.0)).count(),
+                   milliseconds(summary.latency.get_percentile(99.0)).count(), milliseconds(summary.latency.get_percentile(99.9)).count(),
+                   milliseconds(summary.latency.get_max()).count());
+        fmt::print(out, "{}\n", summary.slowest.empty() ? "" : fmt::format(" ({})", summary.slowest.front().path));
+    }
+
+    // Hardware counters depend on the platform and on "perf_event_paranoid", so the run continues without them
+    fmt::print(out, "\nHardware counters per phase, summed over all threads:\n");
+    const auto is_counted = [&summary](const core::perf::Event event) { return summary.counted[static_cast<std::size_t>(event)]; };
+    if (!summary.counters_error.empty() || !is_counted(core::perf::Event::Cycles)) {
+        fmt::print(out, "unavailable ({})\n", summary.counters_error.empty() ? "cycles not supported" : summary.counters_error);
+    }
+    else {
+        // Misses are relative to the input, so that runs on different corpora can be compared
+        const double kilobytes = std::max(static_cast<double>(summary.bytes) / 1e3, 1e-9);
+        for (std::size_t i = 0; i < core::stats::phase_count; ++i) {
+            const auto &values = summary.events[i].values;
+            const auto get = [&values](const core::perf::Event event) { return static_cast<double>(values[static_cast<std::size_t>(event)]); };
+            fmt::print(out, "{}: {:.2f}M cycles", core::stats::get_phase_name(static_cast<core::stats::Phase>(i)), get(core::perf::Event::Cycles) / 1e6);
+            if (is_counted(core::perf::Event::Instructions)) {
+                fmt::print(out, ", {:.2f}M instructions, {:.2f} IPC", get(core::perf::Event::Instructions) / 1e6,
+                           get(core::perf::Event::Cycles) == 0.0 ? 0.0 : get(core::perf::Event::Instructions) / get(core::perf::Event::Cycles));
+            }
+            for (const auto event : {core::perf::Event::BranchMisses, core::perf::Event::LlcMisses}) {
+                if (is_counted(event)) {
+                    fmt::print(out, ", {:.2f} {}/KB", get(event) / kilobytes, core::perf::get_event_name(event));
+                }
+            }
+            fmt::print(out, "\n");
+        }
+    }
+
+    // Peak memory is always available, allocations only in builds with "ENABLE_ALLOC_STATS"
+    if (const auto peak_rss = core::stats::get_peak_rss()) {
+        fmt::print(out, "\nPeak RSS: {:.2f} MB\n", static_cast<double>(*peak_rss) / 1e6);
+    }
+    if constexpr (core::stats::alloc_tracking) {
+        fmt::print(out, "\nAllocations per phase, summed over all threads:\n");
+        for (std::size_t i = 0; i <= core::stats::phase_count; ++i) {
+            fmt::print(out, "{}: {} allocations, {:.2f} MB\n",
+                       i < core::stats::phase_count ? core::stats::get_phase_name(static_cast<core::stats::Phase>(i)) : "other",
+                       summary.allocations[i], static_cast<double>(summary.allocated_bytes[i]) / 1e6);
+        }
+    }
+
+    fmt::print(out, "\n-- SLOWEST {} FILES --\n\n", summary.slowest.size());
+    for (const auto &file : summary.slowest) {
+        fmt::print(out, "{:.2f} ms: {}\n", milliseconds(file.elapsed).count(), file.path);
+    }
+
+    if constexpr (core::stats::alloc_tracking) {
+        fmt::print(out, "\n-- TOP {} ALLOCATING FILES --\n\n", summary.top_allocating.size());
+        for (const auto &file : summary.top_allocating) {
+            fmt::print(out, "{:.2f} MB in {} allocations: {}\n", static_cast<double>(file.bytes) / 1e6, file.allocations, file.path);
+        }
+    }
+    fmt::print(out, "\n--------------------------------------------------------------------------------\n\n");
+}
+
+}  // namespace
+
+void run(const core::args::Args &args,
+         std::FILE *out)
+{
+    // Answer a query from the symbol index, without analyzing any files
+    if (args.query) {
+        const auto start = std::chrono::steady_clock::now();
+        const modules::index::IndexReader reader(args.query->index_path);
+        const auto hits = reader.find(args.query->function);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        for (const auto &hit : hits) {
+            fmt::print(out, "{}:{}: {}\n", hit.file, hit.number, hit.kind == modules::analyze::Occurrence::Kind::Used ? "used" : "listed");
+        }
+        fmt::print(out, "\nFound {} occurrences of '{}' in {} indexed files ({:.2f} ms).\n",
+                   hits.size(), args.query->function, reader.get_file_count(), elapsed.count());
+        return;
+    }
+
+    // Measure the run for the statistics, the part of the traversal that ran while parsing the arguments is added to it for the total
+    const auto run_start = std::chrono::steady_clock::now();
+    const auto setup = args.enable.stats ? core::stats::collect().phases[static_cast<std::size_t>(core::stats::Phase::Traverse)] : std::chrono::nanoseconds{0};
+
+    // Create a thread pool unless a single file is analyzed or multithreading is disabled, with one thread per hardware thread unless requested otherwise
+    // The files are only found while they are analyzed, so any directory might hold more than one
+    const bool single_file = args.inputs.size() < 2 && (args.inputs.empty() || !std::filesystem::is_directory(args.inputs.front()));
+    const std::unique_ptr<BS::thread_pool> pool =
+        (single_file || !args.enable.multithreading) ? nullptr : std::make_unique<BS::thread_pool>(static_cast<BS::concurrency_t>(args.threads));
+
+    // Create the include graph if enabled, it is shared by all threads, so that each header is parsed only once
+    // Pairing uses the same cache, so that a paired header is analyzed once and shared with its source file
+    // With header discovery, every header the graph parses is analyzed later, so the graph keeps its parser for the analysis to take over
+    const bool discover_headers = (args.enable.include_graph || args.enable.pair) && args.enable.discover_headers;
+    const std::unique_ptr<modules::graph::IncludeGraph> graph =
+        (args.enable.include_graph || args.enable.pair) ? std::make_unique<modules::graph::IncludeGraph>(args.include_directories, discover_headers) : nullptr;
+
+    // Walk the inputs lazily, so that only the files in flight are held in memory
+    core::args::FileWalker walker(args.inputs);
+
+    // Discover the project headers reachable from the files while the files are analyzed, e.g., when the files come from a compilation database
+    // The headers are analyzed after all files, in sorted order, skipping the files that were already analyzed; the database already lists the files, so remembering them does not add to the memory by much
+    std::mutex discovered_mutex;
+    std::unordered_set<std::string> analyzed_files;
+    std::set<std::string> discovered_headers;
+
+    // In diff mode, only the patch is printed, so that it can be piped into "git apply"
+    if (!args.enable.diff) {
+        fmt::print(out, "Analyzing files in: [{}]\n\n",
+                   fmt::join(core::string::paths_to_strings(args.inputs), ", "));
+        // fmt::print(out, "Enabled: bare={}, unused={}, unlisted={}, multithreading={}\n\n\n",
+        //            args.enable.bare, args.enable.unused, args.enable.unlisted, args.enable.multithreading);
+
+        fmt::print(out, "--------------------------------------------------------------------------------\n\n");
+    }
+
+    // Create a mutex for thread-safe printing, waiting for it and printing are traced as separate spans
+    std::mutex output_mutex;
+
+    // Create the symbol index writer if requested, it is shared by all threads
+    const std::unique_ptr<modules::index::IndexWriter> index_writer =
+        args.index_path.empty() ? nullptr : std::make_unique<modules::index::IndexWriter>();
+
+    // Create the symbol counter if requested, with one shard per worker thread and one for the calling thread
+    const std::size_t shard_count = pool ? pool->get_thread_count() + 1 : 1;
+    const std::unique_ptr<modules::aggregate::SymbolCounter> symbol_counter =
+        args.stats_symbols == 0 ? nullptr : std::make_unique<modules::aggregate::SymbolCounter>(shard_count);
+
+    // Diffs are rendered by the worker threads, then printed in file order, so that the patch is deterministic
+    // The threads may hold as many diffs as files may be queued for them, before a thread that is too far ahead waits for the earlier diffs
+    DiffPrinter diff_printer(out, shard_count * files_per_worker);
 
     // Function to process a single file
-    const auto process_file = [&args, &sync_out](const std::filesystem::path &path) {
-        std::ostringstream oss;
-        oss << fmt::format("##- {} -##\n\n", path.string());
-        const modules::analyze::CodeParser parser(path);
+    const auto process_file = [&args, &diff_printer, &output_mutex, &graph, &index_writer, &symbol_counter, shard_count, out,
+                               discover_headers, &discovered_mutex, &analyzed_files, &discovered_headers](const std::size_t i,
+                                                                                                          const std::filesystem::path &path) {
+        const core::stats::ScopedFile file_stats(path);
+        const core::trace::ScopedSpan file_span("file", path);
+
+        // Take over the parser of a discovered header, which the include graph already parsed, otherwise parse the file on this thread
+        // The include graph keeps the summary of a header, so that the files including it do not parse it again
+        // Source files are rarely included, so their summaries are not kept, and the memory does not grow with the number of files
+        std::optional<modules::analyze::CodeParser> kept_parser = discover_headers ? graph->take_parser(path) : std::nullopt;
+        modules::analyze::CodeParser parser = kept_parser ? std::move(*kept_parser) : modules::analyze::CodeParser(path);
+        kept_parser.reset();
+        if (graph && !modules::graph::is_source_file(path)) {
+            static_cast<void>(graph->get_summary(path, parser));
+        }
+
+        // Inherit the functions listed in the included headers if enabled, and remember the headers for the analysis if they are discovered
+        if (args.enable.include_graph || discover_headers) {
+            const auto headers = graph->get_reachable_headers(path, parser);
+            if (args.enable.include_graph) {
+                parser.inherit_listed_functions(graph->get_listed_functions(headers));
+            }
+            if (discover_headers) {
+                const std::lock_guard<std::mutex> lock(discovered_mutex);
+                analyzed_files.insert(path.string());
+                for (const auto &header : headers) {
+                    discovered_headers.insert(header.string());
+                }
+            }
+        }
+
+        // Inherit the functions listed in the paired header (e.g., "foo.hpp" for "foo.cpp") if enabled
+        if (args.enable.pair) {
+            if (const auto header = modules::graph::find_paired_header(path)) {
+                parser.inherit_listed_functions(graph->get_summary(*header)->listed_functions);
+            }
+        }
+
+        // Add the occurrences to the symbol index if requested
+        if (index_writer) {
+            index_writer->add(path, parser);
+        }
+
+        // Count the findings in this thread's shard if requested, the calling thread has no pool index and uses the last shard
+        if (symbol_counter) {
+            symbol_counter->add(BS::this_thread::get_index().value_or(shard_count - 1), parser);
+        }
+
+        // Render the changes that would be fixed instead of the report if requested
+        if (args.enable.diff) {
+            const core::stats::ScopedPhase report_phase(core::stats::Phase::Report);
+            std::optional<core::trace::ScopedSpan> format_span(std::in_place, "format");
+            std::string diff = modules::fix::diff_file(path, parser, {args.enable.unused, args.enable.unlisted, args.enable.insert_includes});
+            format_span.reset();
+
+            // Print this diff and any that were waiting for it, in file order
+            diff_printer.print(i, std::move(diff));
+            return;
+        }
+
+        // Without the report, only fix the file if requested, nothing is formatted or printed, so the threads never wait for the output
+        if (!args.enable.report) {
+            if (args.enable.fix) {
+                const core::trace::ScopedSpan fix_span("fix");
+                modules::fix::fix_file(path, parser, {args.enable.unused, args.enable.unlisted, args.enable.insert_includes});
+            }
+            return;
+        }
+
+        const core::stats::ScopedPhase report_phase(core::stats::Phase::Report);
+        // The span is ended before printing, so that it only covers the formatting
+        std::optional<core::trace::ScopedSpan> format_span(std::in_place, "format");
+        // Render into this thread's report buffer, it is cleared but keeps its capacity, so that later files do not grow it again
+        thread_local std::string report;
+        report.clear();
+        const auto report_it = std::back_inserter(report);
+        fmt::format_to(report_it, "##- {} -##\n\n", path.string());
 
         // Get references to the parser's extracted data / results
         const auto &bare_includes = parser.get_bare_includes();
         const auto &unused_functions = parser.get_unused_functions();
         const auto &unlisted_functions = parser.get_unlisted_functions();
+        const auto &redundant_includes = parser.get_redundant_includes();
+        const auto &misattributed_functions = parser.get_misattributed_functions();
 
         // Collect bare includes
         if (!bare_includes.empty()) {
-            oss << "-- 1) BARE INCLUDES --\n\n";
+            report += "-- 1) BARE INCLUDES --\n\n";
             if (args.enable.bare) {
                 for (const auto &entry : bare_includes) {
-                    oss << fmt::format("{}| {}\n", entry.number, entry.text);
-                    oss << "-> Bare include directive.\n";
-                    oss << fmt::format("-> Add a comment to '{}', e.g., '{} // for std::foo, std::bar'.\n\n",
-                                       entry.header, entry.header);
+                    fmt::format_to(report_it, "{}| {}\n", entry.number, entry.text);
+                    report += "-> Bare include directive.\n";
+                    fmt::format_to(report_it, "-> Add a comment to '{}', e.g., '{} // for std::foo, std::bar'.\n\n",
+                                   entry.header, entry.header);
                 }
             }
             else {
-                oss << fmt::format("-> Disabled, but found {} bare include directives.\n\n",
-                                   bare_includes.size());
+                fmt::format_to(report_it, "-> Disabled, but found {} bare include directives.\n\n",
+                               bare_includes.size());
             }
         }
 
         // Collect unused functions
         if (!unused_functions.empty()) {
-            oss << "-- 2) UNUSED FUNCTIONS --\n\n";
+            report += "-- 2) UNUSED FUNCTIONS --\n\n";
             if (args.enable.unused) {
                 for (const auto &entry : unused_functions) {
-                    oss << fmt::format("{}| {}\n", entry.number, entry.text);
-                    oss << "-> Unused functions listed as comments.\n";
-                    oss << fmt::format("-> Remove '{}' comments from '{}'.\n\n",
-                                       fmt::join(entry.unused_functions, "', '"), entry.text);
+                    fmt::format_to(report_it, "{}| {}\n", entry.number, entry.text);
+                    report += "-> Unused functions listed as comments.\n";
+                    fmt::format_to(report_it, "-> Remove '{}' comments from '{}'.\n\n",
+                                   fmt::join(entry.unused_functions, "', '"), entry.text);
                 }
             }
             else {
-                oss << fmt::format("-> Disabled, but found {} unused functions.\n\n",
-                                   unused_functions.size());
+                fmt::format_to(report_it, "-> Disabled, but found {} unused functions.\n\n",
+                               unused_functions.size());
             }
         }
 
         // Collect unlisted functions
         if (!unlisted_functions.empty()) {
-            oss << "-- 3) UNLISTED FUNCTIONS --\n\n";
+            report += "-- 3) UNLISTED FUNCTIONS --\n\n";
             if (args.enable.unlisted) {
-                for (const auto &entry : unlisted_functions) {
-                    oss << fmt::format("{}| {}\n", entry.number, entry.text);
-                    oss << "-> Unlisted function.\n";
-                    oss << fmt::format("-> Add '{}' as a comment, e.g., '#include <foo> // for {}'.\n",
-                                       entry.function, entry.function);
-                    oss << fmt::format("-> Reference: {}\n\n", entry.link);
+                for (std::size_t row = 0; row < unlisted_functions.size(); ++row) {
+                    const auto entry = unlisted_functions.get(row);
+                    const std::string_view function = entry.get_function();
+                    fmt::format_to(report_it, "{}| {}\n", entry.number, parser.get_line(entry.number));
+                    report += "-> Unlisted function.\n";
+                    fmt::format_to(report_it, "-> Add '{}' as a comment, e.g., '#include <{}> // for {}'.\n",
+                                   function, core::stdlib::find_primary_header(function).value_or("foo"), function);
+                    fmt::format_to(report_it, "-> Reference: {}\n\n", entry.get_link());
+                }
+            }
+            else {
+                fmt::format_to(report_it, "-> Disabled, but found {} unlisted functions.\n\n",
+                               unlisted_functions.size());
+            }
+        }
+
+        // Collect redundant includes
+        if (!redundant_includes.empty()) {
+            report += "-- 4) REDUNDANT INCLUDES --\n\n";
+            if (args.enable.redundant) {
+                for (const auto &entry : redundant_includes) {
+                    fmt::format_to(report_it, "{}| {}\n", entry.number, entry.text);
+                    report += "-> Redundant include directive.\n";
+                    fmt::format_to(report_it, "-> Remove '#include <{}>', it provides none of the functions used in the code.\n\n",
+                                   entry.header);
                 }
             }
             else {
-                oss << fmt::format("-> Disabled, but found {} unlisted functions.\n\n",
-                                   unlisted_functions.size());
+                fmt::format_to(report_it, "-> Disabled, but found {} redundant include directives.\n\n",
+                               redundant_includes.size());
+            }
+        }
+
+        // Collect misattributed functions
+        if (!misattributed_functions.empty()) {
+            report += "-- 5) MISATTRIBUTED FUNCTIONS --\n\n";
+            if (args.enable.misattributed) {
+                for (const auto &entry : misattributed_functions) {
+                    fmt::format_to(report_it, "{}| {}\n", entry.number, entry.text);
+                    if (entry.kind == modules::analyze::MisattributedFunction::Kind::WrongHeader) {
+                        fmt::format_to(report_it, "-> Function '{}' is not provided by '<{}>'.\n", entry.function, entry.header);
+                        fmt::format_to(report_it, "-> Move it to '#include <{}> // for {}'.\n\n", entry.suggestion, entry.function);
+                    }
+                    else {
+                        fmt::format_to(report_it, "-> Unknown function '{}'.\n", entry.function);
+                        fmt::format_to(report_it, "-> Did you mean '{}'?\n\n", entry.suggestion);
+                    }
+                }
+            }
+            else {
+                fmt::format_to(report_it, "-> Disabled, but found {} misattributed functions.\n\n",
+                               misattributed_functions.size());
             }
         }
 
         // If nothing found, print OK
-        if (bare_includes.empty() && unused_functions.empty() && unlisted_functions.empty()) {
-            oss << "-> OK.\n\n";
+        if (bare_includes.empty() && unused_functions.empty() && unlisted_functions.empty() && redundant_includes.empty() && misattributed_functions.empty()) {
+            report += "-> OK.\n\n";
         }
 
-        oss << "--------------------------------------------------------------------------------\n\n";
+        // Rewrite the file in place if requested, only the enabled kinds of findings are fixed
+        if (args.enable.fix) {
+            const core::trace::ScopedSpan fix_span("fix");
+            if (modules::fix::fix_file(path, parser, {args.enable.unused, args.enable.unlisted, args.enable.insert_includes})) {
+                report += "-> Fixed in place.\n\n";
+            }
+        }
 
-        // Use synced stream to print the output
-        sync_out.print(oss.str());
+        report += "--------------------------------------------------------------------------------\n\n";
+        format_span.reset();
+
+        // Print the output under the mutex, so that the reports of different files are not interleaved
+        std::unique_lock<std::mutex> lock(output_mutex, std::defer_lock);
+        {
+            const core::trace::ScopedSpan wait_span("wait-for-output-lock");
+            lock.lock();
+        }
+        const core::trace::ScopedSpan write_span("write");
+        fmt::print(out, "{}", report);
     };
 
-    if (args.filepaths.size() < 2 || !args.enable.multithreading) {
-        // Sequential processing for less than 2 files or if multithreading is disabled
-        // fmt::print("Processing files sequentially...\n\n");
-        for (const auto &path : args.filepaths) {
-            process_file(path);
+    // A failed file never prints its diff, so the threads that wait for it are released before the failure is rethrown
+    // The files are numbered from "first", so that the discovered headers are printed after the files in diff mode
+    const auto process_files = [&process_file, &diff_printer, &pool](const auto &next,
+                                                                      const std::size_t first) {
+        return for_each_file(next, pool.get(), [&process_file, &diff_printer, first](const std::size_t i,
+                                                                                     const std::filesystem::path &path) {
+            try {
+                process_file(first + i, path);
+            }
+            catch (...) {
+                diff_printer.abort();
+                throw;
+            }
+        });
+    };
+
+    // Process each file, in parallel if the thread pool was created
+    const auto analysis_start = std::chrono::steady_clock::now();
+    std::size_t file_count = process_files([&walker]() { return walker.next(); }, 0);
+
+    // Then process the discovered headers that were not analyzed yet, their parsers are taken over from the include graph
+    if (discover_headers) {
+        std::vector<std::filesystem::path> headers;
+        for (const auto &header : discovered_headers) {
+            if (analyzed_files.find(header) == analyzed_files.cend()) {
+                headers.emplace_back(header);
+            }
         }
+        std::size_t position = 0;
+        const auto next_header = [&headers, &position]() -> std::optional<std::filesystem::path> {
+            if (position == headers.size()) {
+                return std::nullopt;
+            }
+            return std::move(headers[position++]);
+        };
+        file_count += process_files(next_header, file_count);
     }
-    else {
-        // Parallel processing for 2 or more files
-        // Create a thread pool
-        BS::thread_pool pool;
+    const auto analysis_end = std::chrono::steady_clock::now();
 
-        // Collect futures in a BS::multi_future
-        BS::multi_future<void> futures;
+    // The number of files is only known once the traversal is done
+    if (!args.enable.diff) {
+        fmt::print(out, "Analyzed {} files.\n\n", file_count);
+    }
 
-        // Process each filepath in parallel
-        // fmt::print("Processing files in parallel...\n\n");
-        for (const auto &path : args.filepaths) {
-            // Submit a task to the thread pool and emplace the future
-            futures.emplace_back(pool.submit_task([path, &process_file]() {
-                process_file(path);
-            }));
+    // Print the most frequent findings across all files, to stderr in diff mode, so that the patch stays clean
+    if (symbol_counter) {
+        std::FILE *summary_out = args.enable.diff ? stderr : out;
+        fmt::print(summary_out, "-- TOP {} UNLISTED FUNCTIONS --\n\n", args.stats_symbols);
+        for (const auto &count : symbol_counter->get_top_unlisted(args.stats_symbols)) {
+            fmt::print(summary_out, "{}: {} occurrences in {} files\n", count.function, count.occurrences, count.files);
         }
+        fmt::print(summary_out, "\n-- TOP {} UNUSED FUNCTIONS --\n\n", args.stats_symbols);
+        for (const auto &count : symbol_counter->get_top_unused(args.stats_symbols)) {
+            fmt::print(summary_out, "{}: {} occurrences in {} files\n", count.function, count.occurrences, count.files);
+        }
+        fmt::print(summary_out, "\n--------------------------------------------------------------------------------\n\n");
+    }
+
+    // Write the symbol index once all files are processed, the message goes to stderr in diff mode, so that the patch stays clean
+    if (index_writer) {
+        index_writer->write(args.index_path);
+        fmt::print(args.enable.diff ? stderr : out, "Symbol index written to: {}\n", args.index_path.string());
+    }
+
+    // Write the trace once all threads are done recording
+    if (!args.trace_path.empty()) {
+        core::trace::write(args.trace_path);
+        fmt::print(args.enable.diff ? stderr : out, "Trace written to: {}\n", args.trace_path.string());
+    }
 
-        // Wait for all tasks to complete and rethrow exceptions
-        futures.get();
+    // Print the statistics last, to stderr in diff mode, so that the patch can still be piped into "git apply"
+    if (args.enable.stats) {
+        print_stats(args.enable.diff ? stderr : out, analysis_end - analysis_start, std::chrono::steady_clock::now() - run_start, setup);
     }
 }
 
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstdio>  // for std::FILE, stdout
+
 #include "core/args.hpp"
 
 namespace app {
@@ -14,7 +16,9 @@ namespace app {
  * @brief Run the application.
  *
  * @param args Parsed command-line arguments.
+ * @param out Stream to print the report to (e.g., "stdout"). The statistics and the trace message are printed to stderr instead in diff mode.
  */
-void run(const core::args::Args &args);
+void run(const core::args::Args &args,
+         std::FILE *out = stdout);
 
 }  // namespace app
@@ -2,8 +2,10 @@
  * @file args.cpp
  */
 
+#include <cstddef>        // for std::size_t
 #include <exception>      // for std::exception
 #include <filesystem>     // for std::filesystem
+#include <optional>       // for std::optional, std::nullopt
 #include <string>         // for std::string
 #include <unordered_set>  // for std::unordered_set
 #include <vector>         // for std::vector
@@ -13,19 +15,82 @@
 #include <fmt/ranges.h>
 
 #include "args.hpp"
+#include "compdb.hpp"
+#include "stats.hpp"
+#include "string.hpp"
+#include "trace.hpp"
 #include "version.hpp"
 
 namespace core::args {
 
+namespace {
+
+/**
+ * @brief Private helper function to get the set of common C++ file extensions.
+ *
+ * @return Reference to the set of extensions (e.g., {".cpp", ".hpp"}).
+ */
+[[nodiscard]] const std::unordered_set<std::string> &get_file_extensions()
+{
+    // TODO: Add a way to manually override this set using a command-line argument
+    static const std::unordered_set<std::string> file_extensions = {".cpp", ".hpp", ".h", ".cxx", ".cc", ".hh", ".hxx", ".tpp"};
+    return file_extensions;
+}
+
+/**
+ * @brief Private helper function to check if a file extension matches any of the C++ file types.
+ *
+ * @param path Path to check (e.g., "~/main.cpp").
+ *
+ * @return True if the path has a C++ file extension, false otherwise.
+ */
+[[nodiscard]] bool is_cpp_file(const std::filesystem::path &path)
+{
+    return get_file_extensions().count(path.extension().string()) != 0;
+}
+
+}  // namespace
+
 Args::Args(const int argc,
            char **argv)
 {
-    // Define a set of common C++ file extensions
-    // TODO: Add a way to manually override this set using a command-line argument
-    const std::unordered_set<std::string> file_extensions = {".cpp", ".hpp", ".h", ".cxx", ".cc", ".hh", ".hxx", ".tpp"};
+    // Handle the "query" subcommand separately, because argparse only checks for subcommands after all positional arguments are consumed
+    if (argc > 1 && std::string(argv[1]) == "query") {
+        argparse::ArgumentParser query_program("header-warden query", PROJECT_VERSION);
+        query_program.set_usage_max_line_width(80);
+        query_program.add_description("Look up a standard function in a symbol index written with '--index'.");
+
+        query_program.add_argument("function")
+            .help("standard function to look up, the namespace prefix is optional");
+
+        query_program.add_argument("--index")
+            .help("index file to query")
+            .default_value(std::string("header-warden.idx"));
+
+        try {
+            // Skip the executable name, so that "query" becomes the program name
+            query_program.parse_args(argc - 1, argv + 1);
+        }
+        catch (const std::exception &e) {
+            throw ArgsError(fmt::format("Error: {}\n\n{}", e.what(), query_program.help().str()));
+        }
+
+        // Functions are stored in lowercase with the "std::" prefix, so normalize the query the same way
+        std::string function = core::string::to_lower(query_program.get<std::string>("function"));
+        if (function.compare(0, 5, "std::") != 0) {
+            function.insert(0, "std::");
+        }
+        this->query = Query{function, std::filesystem::absolute(query_program.get<std::string>("--index")).lexically_normal()};
+        this->enable = Enable{};
+        return;
+    }
 
     // Define paths to be extracted from command-line arguments
     std::vector<std::string> files_or_directories;
+    std::vector<std::string> include_directories_raw;
+    std::string compile_commands_raw;
+    std::string index_raw;
+    std::string trace_raw;
 
     // Initialize ArgumentParser
     argparse::ArgumentParser program("header-warden", PROJECT_VERSION);
@@ -35,7 +100,7 @@ Args::Args(const int argc,
     // Add positional arguments
     program.add_argument("paths")
         .help("files or directories to process")
-        .nargs(argparse::nargs_pattern::at_least_one)
+        .nargs(argparse::nargs_pattern::any)
         .store_into(files_or_directories);
 
     // Add optional arguments
@@ -51,10 +116,71 @@ Args::Args(const int argc,
         .help("disables unlisted functions")
         .flag();
 
+    program.add_argument("--no-redundant")
+        .help("disables redundant include directives")
+        .flag();
+
+    program.add_argument("--no-misattributed")
+        .help("disables functions listed after the wrong header")
+        .flag();
+
     program.add_argument("--no-multithreading")
         .help("disables multithreading")
         .flag();
 
+    program.add_argument("--threads")
+        .help("number of worker threads (default: one per hardware thread)")
+        .scan<'i', int>();
+
+    program.add_argument("--no-report")
+        .help("disables the per-file report, e.g., to only print the statistics")
+        .flag();
+
+    program.add_argument("--include-graph")
+        .help("inherits functions listed in included project headers")
+        .flag();
+
+    program.add_argument("--pair")
+        .help("inherits functions listed in the paired header (e.g., foo.hpp for foo.cpp)")
+        .flag();
+
+    program.add_argument("--fix")
+        .help("rewrites include comments in place to fix unused and unlisted functions")
+        .flag();
+
+    program.add_argument("--diff")
+        .help("prints a unified diff of the changes '--fix' would make instead of the report")
+        .flag();
+
+    program.add_argument("--insert-includes")
+        .help("lets '--fix' and '--diff' insert missing include directives")
+        .flag();
+
+    program.add_argument("-I", "--include-dir")
+        .help("directory to search for quoted includes")
+        .append()
+        .store_into(include_directories_raw);
+
+    program.add_argument("--compile-commands")
+        .help("compilation database to take files and include directories from")
+        .store_into(compile_commands_raw);
+
+    program.add_argument("--index")
+        .help("writes a symbol index for 'header-warden query' to this file")
+        .store_into(index_raw);
+
+    program.add_argument("--stats")
+        .help("reports the time per phase, the throughput and the slowest files")
+        .flag();
+
+    program.add_argument("--trace")
+        .help("writes the spans of work per thread to this file in the Chrome trace-event format")
+        .store_into(trace_raw);
+
+    program.add_argument("--stats-symbols")
+        .help("reports the N most frequently unlisted and unused functions")
+        .scan<'i', int>();
+
     try {
         program.parse_args(argc, argv);
     }
@@ -68,9 +194,78 @@ Args::Args(const int argc,
     this->enable.bare = program["--no-bare"] == false;
     this->enable.unused = program["--no-unused"] == false;
     this->enable.unlisted = program["--no-unlisted"] == false;
+    this->enable.redundant = program["--no-redundant"] == false;
+    this->enable.misattributed = program["--no-misattributed"] == false;
     this->enable.multithreading = program["--no-multithreading"] == false;
+    this->enable.report = program["--no-report"] == false;
+    // Opt-in features are false, unless the user provides the flag
+    this->enable.include_graph = program["--include-graph"] == true;
+    this->enable.pair = program["--pair"] == true;
+    this->enable.fix = program["--fix"] == true;
+    this->enable.diff = program["--diff"] == true;
+    this->enable.insert_includes = program["--insert-includes"] == true;
+    this->enable.stats = program["--stats"] == true;
+    this->enable.discover_headers = false;
+
+    // Throw if both fix modes are requested, the diff is computed against the files on disk, so they cannot be rewritten at the same time
+    if (this->enable.fix && this->enable.diff) {
+        throw ArgsError(fmt::format("Error: --fix and --diff cannot be used together\n\n{}", program.help().str()));
+    }
+
+    // Throw if includes shall be inserted without a fix mode, since the report never changes any files
+    if (this->enable.insert_includes && !this->enable.fix && !this->enable.diff) {
+        throw ArgsError(fmt::format("Error: --insert-includes requires --fix or --diff\n\n{}", program.help().str()));
+    }
+
+    // Throw if the number of functions to report is not positive
+    if (const auto requested_symbols = program.present<int>("--stats-symbols")) {
+        if (*requested_symbols <= 0) {
+            throw ArgsError(fmt::format("Error: --stats-symbols must be positive, got: {}\n\n{}", *requested_symbols, program.help().str()));
+        }
+        this->stats_symbols = static_cast<std::size_t>(*requested_symbols);
+    }
+
+    // Throw if the number of worker threads is not positive
+    if (const auto requested_threads = program.present<int>("--threads")) {
+        if (*requested_threads <= 0) {
+            throw ArgsError(fmt::format("Error: --threads must be positive, got: {}\n\n{}", *requested_threads, program.help().str()));
+        }
+        this->threads = static_cast<std::size_t>(*requested_threads);
+    }
+
+    // Resolve the index path if requested
+    if (!index_raw.empty()) {
+        this->index_path = std::filesystem::absolute(index_raw).lexically_normal();
+    }
+
+    // Error: Neither paths nor a compilation database were provided
+    if (files_or_directories.empty() && compile_commands_raw.empty()) {
+        throw ArgsError(fmt::format("Error: No paths or compilation database provided\n\n{}", program.help().str()));
+    }
+
+    // Resolve the trace path if requested
+    if (!trace_raw.empty()) {
+        this->trace_path = std::filesystem::absolute(trace_raw).lexically_normal();
+    }
+
+    // Start collecting statistics and spans if requested, the traversal below is the first phase of the run
+    core::stats::set_enabled(this->enable.stats);
+    core::stats::reset();
+    core::trace::set_enabled(!this->trace_path.empty());
+    core::trace::reset();
+    const core::stats::ScopedPhase traverse_phase(core::stats::Phase::Traverse);
 
-    // Process each path provided by the user
+    // Process each include directory provided by the user
+    for (const auto &directory : include_directories_raw) {
+        const std::filesystem::path resolved_directory = std::filesystem::absolute(directory).lexically_normal();
+        // Throw if doesn't exist or isn't a directory
+        if (!std::filesystem::is_directory(resolved_directory)) {
+            throw ArgsError(fmt::format("Error: Include directory does not exist: {}\n\n{}", resolved_directory.string(), program.help().str()));
+        }
+        this->include_directories.emplace_back(resolved_directory);
+    }
+
+    // Process each path provided by the user, directories are only walked when the files are analyzed
     for (const auto &filepath : files_or_directories) {
         // Get the current iteration as a normalized path
         const std::filesystem::path resolved_filepath = std::filesystem::absolute(filepath).lexically_normal();
@@ -78,33 +273,74 @@ Args::Args(const int argc,
         if (!std::filesystem::exists(resolved_filepath)) {
             throw ArgsError(fmt::format("Error: Path does not exist: {}\n\n{}", resolved_filepath.string(), program.help().str()));
         }
+        this->inputs.emplace_back(resolved_filepath);
+    }
 
-        // If the path is a directory, recursively find all C++ files
-        if (std::filesystem::is_directory(resolved_filepath)) {
-            for (const auto &entry : std::filesystem::recursive_directory_iterator(resolved_filepath)) {
-                // Throw if odesn't exist
-                if (!entry.exists()) {
-                    throw ArgsError(fmt::format("Error: Path does not exist: {}\n\n{}", entry.path().string(), program.help().str()));
-                }
-                // Append only if the file extension matches any of the C++ file types
-                if (file_extensions.find(entry.path().extension().string()) != file_extensions.cend()) {
-                    this->filepaths.emplace_back(entry.path());
-                }
-            }
+    // Load translation units and include directories from the compilation database if provided
+    if (!compile_commands_raw.empty()) {
+        const std::filesystem::path resolved_database = std::filesystem::absolute(compile_commands_raw).lexically_normal();
+        // Throw if doesn't exist
+        if (!std::filesystem::is_regular_file(resolved_database)) {
+            throw ArgsError(fmt::format("Error: Compilation database does not exist: {}\n\n{}", resolved_database.string(), program.help().str()));
         }
-        // Otherwise, use the file path directly
-        else {
-            // Append only if the file extension matches any of the C++ file types
-            if (file_extensions.find(resolved_filepath.extension().string()) != file_extensions.cend()) {
-                this->filepaths.emplace_back(resolved_filepath);
+        const auto database = core::compdb::read_compile_commands(resolved_database);
+
+        // Append only existing files whose extension matches any of the C++ file types (e.g., skip C files)
+        for (const auto &filepath : database.files) {
+            if (is_cpp_file(filepath) && std::filesystem::is_regular_file(filepath)) {
+                this->inputs.emplace_back(filepath);
             }
         }
+        this->include_directories.insert(this->include_directories.cend(), database.include_directories.cbegin(), database.include_directories.cend());
+
+        // Headers are not listed in the database, so they are discovered through the include graph
+        this->enable.include_graph = true;
+        this->enable.discover_headers = true;
+        files_or_directories.emplace_back(resolved_database.string());
     }
 
-    // Throw if no C++ files were found
-    if (this->filepaths.empty()) {
+    // Throw if no C++ files were found, the walk stops at the first file, so this does not traverse the whole tree
+    if (!FileWalker(this->inputs).next()) {
         // fmt can print a set directly, but fmt::join will prevent it from adding curly braces
-        throw ArgsError(fmt::format("Error: No C++ files ({}) found in provided paths: {}\n\n{}", fmt::join(file_extensions, ", "), fmt::join(files_or_directories, ", "), program.help().str()));
+        throw ArgsError(fmt::format("Error: No C++ files ({}) found in provided paths: {}\n\n{}", fmt::join(get_file_extensions(), ", "), fmt::join(files_or_directories, ", "), program.help().str()));
+    }
+}
+
+FileWalker::FileWalker(const std::vector<std::filesystem::path> &inputs)
+    : inputs_(inputs) {}
+
+std::optional<std::filesystem::path> FileWalker::next()
+{
+    const core::stats::ScopedPhase traverse_phase(core::stats::Phase::Traverse);
+    const std::filesystem::recursive_directory_iterator end;
+    for (;;) {
+        // Continue the walk of the current directory
+        while (directory_ != end) {
+            const std::filesystem::directory_entry entry = *directory_;
+            ++directory_;
+            // Throw if doesn't exist
+            if (!entry.exists()) {
+                throw ArgsError(fmt::format("Error: Path does not exist: {}", entry.path().string()));
+            }
+            // Yield only if the file extension matches any of the C++ file types
+            if (is_cpp_file(entry.path())) {
+                return entry.path();
+            }
+        }
+
+        // Stop once all inputs have been walked
+        if (index_ == inputs_.size()) {
+            return std::nullopt;
+        }
+
+        // If the input is a directory, recursively find all C++ files, otherwise, use the file path directly
+        const std::filesystem::path &input = inputs_[index_++];
+        if (std::filesystem::is_directory(input)) {
+            directory_ = std::filesystem::recursive_directory_iterator(input);
+        }
+        else if (is_cpp_file(input)) {
+            return input;
+        }
     }
 }
 
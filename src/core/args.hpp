@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <cstddef>     // for std::size_t
 #include <filesystem>  // for std::filesystem
+#include <optional>    // for std::optional
 #include <stdexcept>   // for std::runtime_error
+#include <string>      // for std::string
 #include <vector>      // for std::vector
 
 namespace core::args {
@@ -45,16 +48,85 @@ struct Enable final {
      */
     bool unlisted;
 
+    /**
+     * @brief If true, enable redundant include directives.
+     */
+    bool redundant;
+
+    /**
+     * @brief If true, enable misattributed functions.
+     */
+    bool misattributed;
+
     /**
      * @brief If true, enable multithreading.
      */
     bool multithreading;
+
+    /**
+     * @brief If true, enable the per-file report.
+     */
+    bool report;
+
+    /**
+     * @brief If true, resolve quoted include directives and inherit the functions listed in the included project headers.
+     */
+    bool include_graph;
+
+    /**
+     * @brief If true, inherit the functions listed in the paired header of each source file (e.g., "foo.hpp" for "foo.cpp").
+     */
+    bool pair;
+
+    /**
+     * @brief If true, also analyze the project headers reachable through the include graph (e.g., when the files come from a compilation database).
+     */
+    bool discover_headers;
+
+    /**
+     * @brief If true, rewrite the analyzed files in place to fix unused and unlisted functions.
+     */
+    bool fix;
+
+    /**
+     * @brief If true, print a unified diff of the changes that "fix" would make instead of rewriting the files.
+     */
+    bool diff;
+
+    /**
+     * @brief If true, let "fix" and "diff" insert missing include directives for unlisted functions.
+     */
+    bool insert_includes;
+
+    /**
+     * @brief If true, enable per-phase timing and throughput statistics.
+     */
+    bool stats;
+};
+
+/**
+ * @brief Struct that represents a query of the symbol index (e.g., "header-warden query std::regex").
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Query final {
+    /**
+     * @brief Function to look up, lowercase and prefixed with "std::" (e.g., "std::regex").
+     */
+    std::string function;
+
+    /**
+     * @brief Path to the index file to query (e.g., "~/header-warden.idx").
+     */
+    std::filesystem::path index_path;
 };
 
 /**
  * @brief Class that represents command-line arguments.
  *
- * On construction, the class parses the command-line arguments, then sets the filepaths and enabled features.
+ * On construction, the class parses the command-line arguments, then sets the inputs and enabled features. The inputs are the provided paths and the files taken from a compilation database. Directories are not walked here, so that the memory does not scale with the number of files; use "FileWalker" to find the files to analyze.
+ *
+ * If the first argument is "query", the remaining arguments are parsed as a query of the symbol index instead, and only the "query" member is set.
  *
  * @note This class is marked as `final` to prevent inheritance.
  */
@@ -74,14 +146,86 @@ class Args final {
                   char **argv);
 
     /**
-     * @brief Vector of file paths.
+     * @brief Vector of files and directories to analyze, in the order provided, followed by the files from the compilation database (e.g., {"~/src", "~/main.cpp"}).
      */
-    std::vector<std::filesystem::path> filepaths;
+    std::vector<std::filesystem::path> inputs;
 
     /**
-     * @brief Struct of enabled features (e.g., "Enable(false, true, true, true)").
+     * @brief Vector of directories to search for quoted include directives (e.g., {"~/src"}).
+     */
+    std::vector<std::filesystem::path> include_directories;
+
+    /**
+     * @brief Path to write the symbol index to after the analysis, or an empty path if no index is requested (e.g., "~/header-warden.idx").
+     */
+    std::filesystem::path index_path;
+
+    /**
+     * @brief Path to the Chrome trace-event file to write (e.g., "~/trace.json"). Empty if no trace was requested.
+     */
+    std::filesystem::path trace_path;
+
+    /**
+     * @brief Number of most frequently unlisted and unused functions to report at the end, or 0 to disable the report (e.g., "10").
+     */
+    std::size_t stats_symbols = 0;
+
+    /**
+     * @brief Number of worker threads, or 0 to use one per hardware thread (e.g., "4").
+     */
+    std::size_t threads = 0;
+
+    /**
+     * @brief Query of the symbol index, if the "query" subcommand is used.
+     */
+    std::optional<Query> query;
+
+    /**
+     * @brief Struct of enabled features (e.g., "Enable(false, true, true, true, true, true, true, false, false, false, false, false, false, false)").
      */
     Enable enable;
 };
 
+/**
+ * @brief Class that represents a lazy walk over the C++ files of a list of inputs.
+ *
+ * Files are yielded one at a time, in the order of the inputs, and directories are walked recursively only as far as needed, so that the memory does not depend on the number of files found.
+ *
+ * @note This class is marked as `final` to prevent inheritance. The inputs must outlive the walker.
+ */
+class FileWalker final {
+  public:
+    /**
+     * @brief Construct a new FileWalker object.
+     *
+     * @param inputs Files and directories to walk (e.g., "args.inputs").
+     */
+    explicit FileWalker(const std::vector<std::filesystem::path> &inputs);
+
+    /**
+     * @brief Get the next file whose extension matches any of the C++ file types.
+     *
+     * @return Path to the file, or std::nullopt if all inputs have been walked.
+     *
+     * @throws ArgsError If a path found in a directory does not exist.
+     */
+    [[nodiscard]] std::optional<std::filesystem::path> next();
+
+  private:
+    /**
+     * @brief Files and directories to walk.
+     */
+    const std::vector<std::filesystem::path> &inputs_;
+
+    /**
+     * @brief Index of the next input to walk.
+     */
+    std::size_t index_ = 0;
+
+    /**
+     * @brief Position in the directory that is being walked, or the end iterator if there is none.
+     */
+    std::filesystem::recursive_directory_iterator directory_;
+};
+
 }  // namespace core::args
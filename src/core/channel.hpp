@@ -0,0 +1,127 @@
+/**
+ * @file channel.hpp
+ *
+ * @brief Pass items between threads through a bounded queue.
+ */
+
+#pragma once
+
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for std::size_t
+#include <deque>               // for std::deque
+#include <mutex>               // for std::mutex, std::unique_lock
+#include <optional>            // for std::optional, std::nullopt
+#include <utility>             // for std::move
+
+namespace core::channel {
+
+/**
+ * @brief Class that represents a bounded multi-producer, multi-consumer queue.
+ *
+ * Producers block while the channel is full, so that a fast producer (e.g., a directory walk) cannot get ahead of the consumers by more than the capacity. Consumers block while the channel is empty, until an item is pushed or the channel is closed.
+ *
+ * @tparam T Type of the items (e.g., "std::filesystem::path").
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+template <typename T>
+class Channel final {
+  public:
+    /**
+     * @brief Construct a new Channel object.
+     *
+     * @param capacity Maximum number of items held at once, at least 1 (e.g., "64").
+     */
+    explicit Channel(const std::size_t capacity)
+        : capacity_(capacity == 0 ? 1 : capacity) {}
+
+    Channel(const Channel &) = delete;
+    Channel &operator=(const Channel &) = delete;
+
+    /**
+     * @brief Push an item, waiting while the channel is full.
+     *
+     * @param item Item to push.
+     *
+     * @return True if the item was pushed, false if the channel was closed (e.g., because a consumer failed), in which case the producer should stop.
+     */
+    [[nodiscard]] bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.emplace_back(std::move(item));
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Pop the oldest item, waiting while the channel is empty and open.
+     *
+     * @return Item, or std::nullopt once the channel is closed and drained.
+     */
+    [[nodiscard]] std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> item(std::move(items_.front()));
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+        return item;
+    }
+
+    /**
+     * @brief Close the channel, waking up all waiting threads.
+     *
+     * Items that were already pushed can still be popped, but further pushes are rejected.
+     */
+    void close()
+    {
+        {
+            const std::unique_lock<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+  private:
+    /**
+     * @brief Maximum number of items held at once.
+     */
+    const std::size_t capacity_;
+
+    /**
+     * @brief Mutex that protects the members below.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @brief Signalled when an item is popped or the channel is closed.
+     */
+    std::condition_variable not_full_;
+
+    /**
+     * @brief Signalled when an item is pushed or the channel is closed.
+     */
+    std::condition_variable not_empty_;
+
+    /**
+     * @brief Items in the order they were pushed.
+     */
+    std::deque<T> items_;
+
+    /**
+     * @brief If true, the channel was closed.
+     */
+    bool closed_ = false;
+};
+
+}  // namespace core::channel
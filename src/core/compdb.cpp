@@ -0,0 +1,554 @@
+/**
+ * @file compdb.cpp
+ */
+
+#include <array>          // for std::array
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint32_t
+#include <exception>      // for std::exception
+#include <filesystem>     // for std::filesystem
+#include <fstream>        // for std::ifstream
+#include <ios>            // for std::ios, std::streamsize
+#include <istream>        // for std::istream
+#include <stdexcept>      // for std::runtime_error
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <unordered_set>  // for std::unordered_set
+#include <utility>        // for std::move
+#include <vector>         // for std::vector
+
+#include <fmt/core.h>
+
+#include "compdb.hpp"
+
+namespace core::compdb {
+
+namespace {
+
+/**
+ * @brief Private class that reads JSON tokens from a stream through a fixed-size buffer.
+ *
+ * Only the subset of JSON needed to walk a compilation database is exposed: strings, arrays of strings, and skipping of any other value.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class JsonReader final {
+  public:
+    /**
+     * @brief Construct a new JsonReader object.
+     *
+     * @param stream Input stream opened in binary mode.
+     */
+    explicit JsonReader(std::istream &stream)
+        : stream_(stream) {}
+
+    /**
+     * @brief Skip whitespace, then return the next character without consuming it.
+     *
+     * @return Next character, or '\0' at the end of the stream.
+     */
+    [[nodiscard]] char peek()
+    {
+        this->skip_whitespace();
+        return this->fill() ? this->buffer_[this->position_] : '\0';
+    }
+
+    /**
+     * @brief Skip whitespace, then consume the expected character.
+     *
+     * @param expected Character that must come next (e.g., '{').
+     *
+     * @throws std::runtime_error If a different character or the end of the stream is found.
+     */
+    void expect(const char expected)
+    {
+        if (this->peek() != expected) {
+            this->fail(fmt::format("expected '{}'", expected));
+        }
+        ++this->position_;
+        ++this->offset_;
+    }
+
+    /**
+     * @brief Skip whitespace, then read a string and decode its escape sequences.
+     *
+     * @return Decoded UTF-8 string (e.g., "main.cpp").
+     *
+     * @throws std::runtime_error If the next value is not a valid string.
+     */
+    [[nodiscard]] std::string read_string()
+    {
+        std::string result;
+        this->expect('"');
+        for (;;) {
+            const char character = this->take();
+            if (character == '"') {
+                return result;
+            }
+            if (character != '\\') {
+                result.push_back(character);
+                continue;
+            }
+            switch (const char escaped = this->take()) {
+            case '"':
+            case '\\':
+            case '/':
+                result.push_back(escaped);
+                break;
+            case 'b':
+                result.push_back('\b');
+                break;
+            case 'f':
+                result.push_back('\f');
+                break;
+            case 'n':
+                result.push_back('\n');
+                break;
+            case 'r':
+                result.push_back('\r');
+                break;
+            case 't':
+                result.push_back('\t');
+                break;
+            case 'u':
+                this->append_code_point(result);
+                break;
+            default:
+                this->fail("invalid escape sequence");
+            }
+        }
+    }
+
+    /**
+     * @brief Read an array of strings (e.g., the "arguments" of an entry).
+     *
+     * @return Vector of decoded strings (e.g., {"c++", "-c", "main.cpp"}).
+     *
+     * @throws std::runtime_error If the next value is not an array of strings.
+     */
+    [[nodiscard]] std::vector<std::string> read_string_array()
+    {
+        std::vector<std::string> result;
+        this->expect('[');
+        if (this->peek() == ']') {
+            this->expect(']');
+            return result;
+        }
+        for (;;) {
+            result.emplace_back(this->read_string());
+            if (this->peek() == ',') {
+                this->expect(',');
+                continue;
+            }
+            this->expect(']');
+            return result;
+        }
+    }
+
+    /**
+     * @brief Skip any JSON value, including nested objects and arrays, without storing it.
+     *
+     * @throws std::runtime_error If the stream ends before the value is complete.
+     */
+    void skip_value()
+    {
+        std::size_t depth = 0;
+        do {
+            switch (const char character = this->peek()) {
+            case '"':
+                this->skip_string();
+                break;
+            case '{':
+            case '[':
+                ++depth;
+                this->take();
+                break;
+            case '}':
+            case ']':
+                if (depth == 0) {
+                    this->fail("unexpected end of value");
+                }
+                --depth;
+                this->take();
+                break;
+            case ',':
+            case ':':
+                if (depth == 0) {
+                    this->fail(fmt::format("unexpected '{}'", character));
+                }
+                this->take();
+                break;
+            case '\0':
+                this->fail("unexpected end of file");
+                break;
+            default:
+                // Literal or number, consume until the next delimiter
+                while (this->fill() && !is_delimiter(this->buffer_[this->position_])) {
+                    this->take();
+                }
+                break;
+            }
+        } while (depth > 0);
+    }
+
+    /**
+     * @brief Throw an exception that includes the current byte offset.
+     *
+     * @param message Description of the error (e.g., "expected '{'").
+     *
+     * @throws std::runtime_error Always.
+     */
+    [[noreturn]] void fail(const std::string &message) const
+    {
+        throw std::runtime_error(fmt::format("Invalid JSON at byte {}: {}", this->offset_, message));
+    }
+
+  private:
+    /**
+     * @brief Check if a character ends a literal or a number.
+     *
+     * @param character Character to check (e.g., ',').
+     *
+     * @return True if the character is whitespace or a structural character, false otherwise.
+     */
+    [[nodiscard]] static bool is_delimiter(const char character)
+    {
+        return character == ',' || character == '}' || character == ']' || character == ' ' ||
+               character == '\n' || character == '\r' || character == '\t';
+    }
+
+    /**
+     * @brief Make sure that at least one unread character is buffered.
+     *
+     * @return True if a character is available, false at the end of the stream.
+     */
+    [[nodiscard]] bool fill()
+    {
+        if (this->position_ < this->size_) {
+            return true;
+        }
+        this->stream_.read(this->buffer_.data(), static_cast<std::streamsize>(this->buffer_.size()));
+        this->size_ = static_cast<std::size_t>(this->stream_.gcount());
+        this->position_ = 0;
+        return this->size_ > 0;
+    }
+
+    /**
+     * @brief Consume the next character, without skipping whitespace.
+     *
+     * @return Consumed character.
+     *
+     * @throws std::runtime_error At the end of the stream.
+     */
+    char take()
+    {
+        if (!this->fill()) {
+            this->fail("unexpected end of file");
+        }
+        ++this->offset_;
+        return this->buffer_[this->position_++];
+    }
+
+    /**
+     * @brief Consume whitespace characters.
+     */
+    void skip_whitespace()
+    {
+        while (this->fill()) {
+            const char character = this->buffer_[this->position_];
+            if (character != ' ' && character != '\n' && character != '\r' && character != '\t') {
+                return;
+            }
+            ++this->position_;
+            ++this->offset_;
+        }
+    }
+
+    /**
+     * @brief Consume a string without decoding or storing it.
+     */
+    void skip_string()
+    {
+        this->expect('"');
+        for (char character = this->take(); character != '"'; character = this->take()) {
+            if (character == '\\') {
+                this->take();
+            }
+        }
+    }
+
+    /**
+     * @brief Read four hexadecimal digits of a "\u" escape sequence.
+     *
+     * @return Decoded code unit (e.g., "0x00E9").
+     */
+    [[nodiscard]] std::uint32_t read_hex4()
+    {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char character = this->take();
+            value <<= 4;
+            if (character >= '0' && character <= '9') {
+                value |= static_cast<std::uint32_t>(character - '0');
+            }
+            else if (character >= 'a' && character <= 'f') {
+                value |= static_cast<std::uint32_t>(character - 'a' + 10);
+            }
+            else if (character >= 'A' && character <= 'F') {
+                value |= static_cast<std::uint32_t>(character - 'A' + 10);
+            }
+            else {
+                this->fail("invalid unicode escape");
+            }
+        }
+        return value;
+    }
+
+    /**
+     * @brief Decode a "\u" escape sequence (including surrogate pairs) and append it as UTF-8.
+     *
+     * @param result String to append to.
+     */
+    void append_code_point(std::string &result)
+    {
+        std::uint32_t code_point = this->read_hex4();
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            // High surrogate, must be followed by "\u" and a low surrogate
+            if (this->take() != '\\' || this->take() != 'u') {
+                this->fail("unpaired surrogate");
+            }
+            const std::uint32_t low = this->read_hex4();
+            if (low < 0xDC00 || low > 0xDFFF) {
+                this->fail("invalid low surrogate");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        if (code_point < 0x80) {
+            result.push_back(static_cast<char>(code_point));
+        }
+        else if (code_point < 0x800) {
+            result.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+            result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+        else if (code_point < 0x10000) {
+            result.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+        else {
+            result.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+        }
+    }
+
+    /**
+     * @brief Input stream.
+     */
+    std::istream &stream_;
+
+    /**
+     * @brief Fixed-size read buffer (64 KiB).
+     */
+    std::array<char, 65536> buffer_{};
+
+    /**
+     * @brief Index of the next unread character in the buffer.
+     */
+    std::size_t position_ = 0;
+
+    /**
+     * @brief Number of valid characters in the buffer.
+     */
+    std::size_t size_ = 0;
+
+    /**
+     * @brief Number of characters consumed so far, used in error messages.
+     */
+    std::size_t offset_ = 0;
+};
+
+/**
+ * @brief Private helper function to resolve a path from the database against the entry's working directory.
+ *
+ * @param path Path as written in the database (e.g., "../src/main.cpp").
+ * @param directory Working directory of the entry (e.g., "~/build").
+ *
+ * @return Absolute, normalized path (e.g., "~/src/main.cpp").
+ */
+[[nodiscard]] std::filesystem::path resolve(const std::string &path,
+                                            const std::filesystem::path &directory)
+{
+    const std::filesystem::path candidate(path);
+    return (candidate.is_absolute() ? candidate : std::filesystem::absolute(directory / candidate)).lexically_normal();
+}
+
+}  // namespace
+
+std::vector<std::string> split_command(const std::string &command)
+{
+    std::vector<std::string> arguments;
+    std::string current;
+    bool in_argument = false;
+    char quote = '\0';
+
+    for (std::size_t i = 0; i < command.size(); ++i) {
+        const char character = command[i];
+        if (quote == '\'') {
+            // Single quotes preserve everything until the closing quote
+            if (character == '\'') {
+                quote = '\0';
+            }
+            else {
+                current.push_back(character);
+            }
+        }
+        else if (character == '\\' && i + 1 < command.size()) {
+            // Backslash escapes the next character, both outside and inside double quotes
+            current.push_back(command[++i]);
+            in_argument = true;
+        }
+        else if (quote == '"') {
+            if (character == '"') {
+                quote = '\0';
+            }
+            else {
+                current.push_back(character);
+            }
+        }
+        else if (character == '"' || character == '\'') {
+            quote = character;
+            in_argument = true;
+        }
+        else if (character == ' ' || character == '\t' || character == '\n') {
+            if (in_argument) {
+                arguments.emplace_back(std::move(current));
+                current.clear();
+                in_argument = false;
+            }
+        }
+        else {
+            current.push_back(character);
+            in_argument = true;
+        }
+    }
+    if (in_argument) {
+        arguments.emplace_back(std::move(current));
+    }
+    return arguments;
+}
+
+Database read_compile_commands(const std::filesystem::path &input_path)
+{
+    try {
+        // Open the file in binary mode, the reader handles line endings itself
+        std::ifstream file(input_path, std::ios::binary);
+
+        // Error: File cannot be opened
+        if (!file) {
+            throw std::runtime_error("Failed to open file for reading");
+        }
+
+        Database database;
+        std::unordered_set<std::string> seen_files;
+        std::unordered_set<std::string> seen_directories;
+
+        // Add an include directive argument (e.g., "-Isrc") to the database, ignoring duplicates
+        const auto add_include_directory = [&database, &seen_directories](const std::string &path, const std::filesystem::path &directory) {
+            auto resolved = resolve(path, directory);
+            if (seen_directories.insert(resolved.string()).second) {
+                database.include_directories.emplace_back(std::move(resolved));
+            }
+        };
+
+        JsonReader reader(file);
+        reader.expect('[');
+        if (reader.peek() == ']') {
+            return database;
+        }
+
+        for (;;) {
+            // Read a single entry, keeping only the relevant keys
+            std::string directory;
+            std::string source;
+            std::string command;
+            std::vector<std::string> arguments;
+
+            reader.expect('{');
+            if (reader.peek() != '}') {
+                for (;;) {
+                    const std::string key = reader.read_string();
+                    reader.expect(':');
+                    if (key == "directory") {
+                        directory = reader.read_string();
+                    }
+                    else if (key == "file") {
+                        source = reader.read_string();
+                    }
+                    else if (key == "command") {
+                        command = reader.read_string();
+                    }
+                    else if (key == "arguments") {
+                        arguments = reader.read_string_array();
+                    }
+                    else {
+                        reader.skip_value();
+                    }
+                    if (reader.peek() != ',') {
+                        break;
+                    }
+                    reader.expect(',');
+                }
+            }
+            reader.expect('}');
+
+            // Error: Entry without a file
+            if (source.empty()) {
+                reader.fail("entry without a \"file\"");
+            }
+
+            // Resolve the translation unit against the entry's working directory
+            const std::filesystem::path working_directory = std::filesystem::absolute(directory.empty() ? input_path.parent_path() : std::filesystem::path(directory));
+            if (auto resolved = resolve(source, working_directory); seen_files.insert(resolved.string()).second) {
+                database.files.emplace_back(std::move(resolved));
+            }
+
+            // Extract include directories from either the argument list or the shell command
+            if (arguments.empty()) {
+                arguments = split_command(command);
+            }
+            for (std::size_t i = 0; i < arguments.size(); ++i) {
+                const std::string &argument = arguments[i];
+                for (const std::string_view flag : {std::string_view("-iquote"), std::string_view("-I")}) {
+                    if (argument.compare(0, flag.size(), flag) != 0) {
+                        continue;
+                    }
+                    if (argument.size() > flag.size()) {
+                        // Joined form (e.g., "-Isrc")
+                        add_include_directory(argument.substr(flag.size()), working_directory);
+                    }
+                    else if (i + 1 < arguments.size()) {
+                        // Separate form (e.g., "-I src")
+                        add_include_directory(arguments[++i], working_directory);
+                    }
+                    break;
+                }
+            }
+
+            // Continue with the next entry or stop at the end of the array
+            if (reader.peek() != ',') {
+                break;
+            }
+            reader.expect(',');
+        }
+        reader.expect(']');
+
+        return database;
+    }
+    catch (const std::exception &e) {
+        throw std::runtime_error(fmt::format("Error loading compilation database '{}': {}", input_path.string(), e.what()));
+    }
+}
+
+}  // namespace core::compdb
@@ -0,0 +1,54 @@
+/**
+ * @file compdb.hpp
+ *
+ * @brief Read translation units and include directories from a compilation database (compile_commands.json).
+ */
+
+#pragma once
+
+#include <filesystem>  // for std::filesystem
+#include <string>      // for std::string
+#include <vector>      // for std::vector
+
+namespace core::compdb {
+
+/**
+ * @brief Struct that represents the parts of a compilation database that are relevant for analysis.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Database final {
+    /**
+     * @brief Vector of unique translation units, in the order they appear in the database (e.g., {"~/src/main.cpp"}).
+     */
+    std::vector<std::filesystem::path> files;
+
+    /**
+     * @brief Vector of unique include directories passed with "-I" or "-iquote", in the order they appear in the database (e.g., {"~/src"}).
+     */
+    std::vector<std::filesystem::path> include_directories;
+};
+
+/**
+ * @brief Split a shell command into arguments, honoring single quotes, double quotes and backslash escapes.
+ *
+ * @param command Command to split (e.g., "c++ -I\"my dir\" -c main.cpp").
+ *
+ * @return Vector of arguments (e.g., {"c++", "-Imy dir", "-c", "main.cpp"}).
+ */
+[[nodiscard]] std::vector<std::string> split_command(const std::string &command);
+
+/**
+ * @brief Load a compilation database from disk.
+ *
+ * The JSON is parsed in a single streaming pass, so only the current entry is held in memory, not the whole document. Relative paths are resolved against each entry's "directory".
+ *
+ * @param input_path Path to the compilation database (e.g., "~/build/compile_commands.json").
+ *
+ * @return Database with unique, absolute and normalized paths.
+ *
+ * @throws std::runtime_error If the file cannot be opened for reading or if it is not a valid compilation database.
+ */
+[[nodiscard]] Database read_compile_commands(const std::filesystem::path &input_path);
+
+}  // namespace core::compdb
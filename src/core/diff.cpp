@@ -0,0 +1,275 @@
+/**
+ * @file diff.cpp
+ */
+
+#include <algorithm>    // for std::reverse, std::min
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include <fmt/core.h>
+
+#include "diff.hpp"
+
+namespace core::diff {
+
+namespace {
+
+/**
+ * @brief Struct that represents a single step of an edit script.
+ */
+struct Operation final {
+    /**
+     * @brief Enum that represents what happens to a line.
+     */
+    enum class Kind {
+        Equal,   // Line is kept, present in both texts
+        Delete,  // Line is only present in the old text
+        Insert   // Line is only present in the new text
+    };
+
+    /**
+     * @brief What happens to the line.
+     */
+    Kind kind;
+
+    /**
+     * @brief Index of the line in the old text, or of the next old line for insertions.
+     */
+    std::size_t old_index;
+
+    /**
+     * @brief Index of the line in the new text, or of the next new line for deletions.
+     */
+    std::size_t new_index;
+};
+
+/**
+ * @brief Private helper function to split a text into lines, each including its "\n" line ending.
+ *
+ * @param text Text to split (e.g., "a\nb").
+ *
+ * @return Vector of views into the text (e.g., {"a\n", "b"}). Only the last line may lack a line ending.
+ */
+[[nodiscard]] std::vector<std::string_view> split_lines(const std::string &text)
+{
+    std::vector<std::string_view> lines;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t stop = text.find('\n', start);
+        stop = stop == std::string::npos ? text.size() : stop + 1;
+        lines.emplace_back(text.data() + start, stop - start);
+        start = stop;
+    }
+    return lines;
+}
+
+/**
+ * @brief Private helper function to find the shortest edit script that turns one sequence of lines into another.
+ *
+ * This is the greedy forward algorithm from Myers' "An O(ND) Difference Algorithm and Its Variations" (1986). Only the diagonals reachable with "d" edits are kept per step, so the trace needs O(D^2) memory.
+ *
+ * @param a Lines of the old text.
+ * @param b Lines of the new text.
+ *
+ * @return Edit script in line order.
+ */
+[[nodiscard]] std::vector<Operation> find_edit_script(const std::vector<std::string_view> &a,
+                                                      const std::vector<std::string_view> &b)
+{
+    const auto n = static_cast<std::ptrdiff_t>(a.size());
+    const auto m = static_cast<std::ptrdiff_t>(b.size());
+
+    // Skip the common prefix and suffix, fixes usually touch only a handful of lines
+    std::ptrdiff_t prefix = 0;
+    while (prefix < n && prefix < m && a[static_cast<std::size_t>(prefix)] == b[static_cast<std::size_t>(prefix)]) {
+        ++prefix;
+    }
+    std::ptrdiff_t suffix = 0;
+    while (suffix < n - prefix && suffix < m - prefix &&
+           a[static_cast<std::size_t>(n - 1 - suffix)] == b[static_cast<std::size_t>(m - 1 - suffix)]) {
+        ++suffix;
+    }
+    const std::ptrdiff_t inner_n = n - prefix - suffix;
+    const std::ptrdiff_t inner_m = m - prefix - suffix;
+    const auto a_at = [&a, prefix](const std::ptrdiff_t i) { return a[static_cast<std::size_t>(prefix + i)]; };
+    const auto b_at = [&b, prefix](const std::ptrdiff_t i) { return b[static_cast<std::size_t>(prefix + i)]; };
+
+    // Find the furthest reaching path on each diagonal "k = x - y" for increasing numbers of edits "d"
+    // The state before each step is kept in "trace", so that the path can be recovered afterwards
+    const std::ptrdiff_t max = inner_n + inner_m;
+    const std::ptrdiff_t offset = max + 1;
+    std::vector<std::ptrdiff_t> v(static_cast<std::size_t>(2 * max + 3), 0);
+    const auto v_at = [&v, offset](const std::ptrdiff_t k) -> std::ptrdiff_t & { return v[static_cast<std::size_t>(k + offset)]; };
+    std::vector<std::vector<std::ptrdiff_t>> trace;
+    std::ptrdiff_t edits = 0;
+    for (std::ptrdiff_t d = 0; d <= max; ++d) {
+        trace.emplace_back(v.cbegin() + (offset - d - 1), v.cbegin() + (offset + d + 2));
+        bool done = false;
+        for (std::ptrdiff_t k = -d; k <= d; k += 2) {
+            // Either move down from diagonal "k + 1" (insertion) or right from diagonal "k - 1" (deletion)
+            std::ptrdiff_t x = (k == -d || (k != d && v_at(k - 1) < v_at(k + 1))) ? v_at(k + 1) : v_at(k - 1) + 1;
+            std::ptrdiff_t y = x - k;
+            // Follow the snake of equal lines
+            while (x < inner_n && y < inner_m && a_at(x) == b_at(y)) {
+                ++x;
+                ++y;
+            }
+            v_at(k) = x;
+            if (x >= inner_n && y >= inner_m) {
+                done = true;
+                break;
+            }
+        }
+        if (done) {
+            edits = d;
+            break;
+        }
+    }
+
+    // Walk back from the end, recovering one edit and its preceding snake per step
+    std::vector<Operation> operations;
+    std::ptrdiff_t x = inner_n;
+    std::ptrdiff_t y = inner_m;
+    const auto emit = [&operations, prefix](const Operation::Kind kind, const std::ptrdiff_t old_index, const std::ptrdiff_t new_index) {
+        operations.push_back({kind, static_cast<std::size_t>(prefix + old_index), static_cast<std::size_t>(prefix + new_index)});
+    };
+    for (std::ptrdiff_t d = edits; d >= 0; --d) {
+        // The saved slice covers the diagonals "-d - 1" to "d + 1"
+        const auto &saved = trace[static_cast<std::size_t>(d)];
+        const auto saved_at = [&saved, d](const std::ptrdiff_t k) { return saved[static_cast<std::size_t>(k + d + 1)]; };
+        const std::ptrdiff_t k = x - y;
+        const bool down = k == -d || (k != d && saved_at(k - 1) < saved_at(k + 1));
+        const std::ptrdiff_t previous_x = d == 0 ? 0 : (down ? saved_at(k + 1) : saved_at(k - 1));
+        const std::ptrdiff_t previous_y = d == 0 ? 0 : previous_x - (down ? k + 1 : k - 1);
+        const std::ptrdiff_t snake_start_x = d == 0 ? 0 : (down ? previous_x : previous_x + 1);
+        while (x > snake_start_x) {
+            --x;
+            --y;
+            emit(Operation::Kind::Equal, x, y);
+        }
+        if (d > 0) {
+            if (down) {
+                emit(Operation::Kind::Insert, previous_x, previous_y);
+            }
+            else {
+                emit(Operation::Kind::Delete, previous_x, previous_y);
+            }
+            x = previous_x;
+            y = previous_y;
+        }
+    }
+    std::reverse(operations.begin(), operations.end());
+
+    // Add the skipped prefix and suffix back as equal lines
+    std::vector<Operation> script;
+    script.reserve(static_cast<std::size_t>(prefix + suffix) + operations.size());
+    for (std::ptrdiff_t i = 0; i < prefix; ++i) {
+        script.push_back({Operation::Kind::Equal, static_cast<std::size_t>(i), static_cast<std::size_t>(i)});
+    }
+    script.insert(script.cend(), operations.cbegin(), operations.cend());
+    for (std::ptrdiff_t i = suffix; i > 0; --i) {
+        script.push_back({Operation::Kind::Equal, static_cast<std::size_t>(n - i), static_cast<std::size_t>(m - i)});
+    }
+    return script;
+}
+
+/**
+ * @brief Private helper function to append a line to a unified diff.
+ *
+ * @param output Diff to append to.
+ * @param marker Line prefix (e.g., '+').
+ * @param line Line including its line ending, if any (e.g., "a\n").
+ */
+void append_line(std::string &output,
+                 const char marker,
+                 const std::string_view line)
+{
+    output += marker;
+    output += line;
+    if (line.empty() || line.back() != '\n') {
+        output += "\n\\ No newline at end of file\n";
+    }
+}
+
+}  // namespace
+
+std::string unified_diff(const std::string &old_text,
+                         const std::string &new_text,
+                         const std::string &label,
+                         const std::size_t context)
+{
+    if (old_text == new_text) {
+        return {};
+    }
+
+    const auto a = split_lines(old_text);
+    const auto b = split_lines(new_text);
+    const auto script = find_edit_script(a, b);
+
+    std::string output = fmt::format("--- a/{}\n+++ b/{}\n", label, label);
+
+    // Group the changes into hunks, changes that are separated by at most "2 * context" equal lines share a hunk
+    std::size_t i = 0;
+    while (i < script.size()) {
+        // Find the next change
+        while (i < script.size() && script[i].kind == Operation::Kind::Equal) {
+            ++i;
+        }
+        if (i == script.size()) {
+            break;
+        }
+        const std::size_t first = i >= context ? i - context : 0;
+
+        // Extend the hunk until the gap of equal lines is too large or the script ends
+        std::size_t last = i;
+        while (last < script.size()) {
+            std::size_t gap = last;
+            while (gap < script.size() && script[gap].kind == Operation::Kind::Equal) {
+                ++gap;
+            }
+            if (gap == script.size() || gap - last > 2 * context) {
+                last = std::min(script.size(), last + context);
+                break;
+            }
+            last = gap;
+            while (last < script.size() && script[last].kind != Operation::Kind::Equal) {
+                ++last;
+            }
+        }
+
+        // Count the lines of each side, a side without lines starts at the line before the hunk
+        std::size_t old_count = 0;
+        std::size_t new_count = 0;
+        for (std::size_t j = first; j < last; ++j) {
+            if (script[j].kind != Operation::Kind::Insert) {
+                ++old_count;
+            }
+            if (script[j].kind != Operation::Kind::Delete) {
+                ++new_count;
+            }
+        }
+        const std::size_t old_start = script[first].old_index + (old_count > 0 ? 1 : 0);
+        const std::size_t new_start = script[first].new_index + (new_count > 0 ? 1 : 0);
+        output += fmt::format("@@ -{},{} +{},{} @@\n", old_start, old_count, new_start, new_count);
+
+        for (std::size_t j = first; j < last; ++j) {
+            switch (script[j].kind) {
+            case Operation::Kind::Equal:
+                append_line(output, ' ', a[script[j].old_index]);
+                break;
+            case Operation::Kind::Delete:
+                append_line(output, '-', a[script[j].old_index]);
+                break;
+            case Operation::Kind::Insert:
+                append_line(output, '+', b[script[j].new_index]);
+                break;
+            }
+        }
+        i = last;
+    }
+    return output;
+}
+
+}  // namespace core::diff
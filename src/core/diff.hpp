@@ -0,0 +1,31 @@
+/**
+ * @file diff.hpp
+ *
+ * @brief Compare two texts line by line and render the differences as a unified diff.
+ */
+
+#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <string>   // for std::string
+
+namespace core::diff {
+
+/**
+ * @brief Render the differences between two texts as a unified diff, as accepted by "git apply" and "patch -p1".
+ *
+ * The shortest edit script is found with Myers' O((N+M)D) algorithm, after the common leading and trailing lines are skipped. A missing final line ending is marked with "\ No newline at end of file".
+ *
+ * @param old_text Original text (e.g., "a\nb\n").
+ * @param new_text Modified text (e.g., "a\nc\n").
+ * @param label Path shown in the file headers, without the "a/" and "b/" prefixes (e.g., "src/main.cpp").
+ * @param context Number of unchanged lines shown around each change (default: 3).
+ *
+ * @return Unified diff including the "---" and "+++" file headers, or an empty string if the texts are identical.
+ */
+[[nodiscard]] std::string unified_diff(const std::string &old_text,
+                                       const std::string &new_text,
+                                       const std::string &label,
+                                       const std::size_t context = 3);
+
+}  // namespace core::diff
@@ -2,23 +2,79 @@
  * @file io.cpp
  */
 
-#include <cstddef>     // for std::size_t
-#include <exception>   // for std::exception
-#include <filesystem>  // for std::filesystem
-#include <fstream>     // for std::ifstream
-#include <stdexcept>   // for std::runtime_error
-#include <string>      // for std::string, std::getline
-#include <vector>      // for std::vector
+#include <cerrno>        // for errno, EEXIST
+#include <cstddef>       // for std::size_t
+#include <cstdio>        // for std::FILE, std::fopen, std::fwrite, std::fclose
+#include <exception>     // for std::exception
+#include <filesystem>    // for std::filesystem
+#include <fstream>       // for std::ifstream
+#include <ios>           // for std::ios, std::streamoff, std::streamsize
+#include <memory>        // for std::unique_ptr
+#include <random>        // for std::random_device
+#include <stdexcept>     // for std::runtime_error
+#include <string>        // for std::string, std::getline
+#include <string_view>   // for std::string_view
+#include <system_error>  // for std::error_code
+#include <utility>       // for std::move
+#include <vector>        // for std::vector
 
 #include <fmt/core.h>
 
 #include "io.hpp"
+#include "stats.hpp"
 
 namespace core::io {
 
+namespace {
+
+/**
+ * @brief Number of random names tried for a temporary file before giving up.
+ */
+constexpr int temp_file_attempts = 100;
+
+/**
+ * @brief Private helper function to create a temporary file with a unique name next to a target file, in the style of "mkstemp".
+ *
+ * The file is created exclusively, so that an existing file of the same name (e.g., one written by another process) is never overwritten.
+ *
+ * @param target_path Path to the file that the temporary file will replace (e.g., "~/data.txt").
+ * @param temp_path Set to the path of the created file (e.g., "~/data.txt.3f2a9c1e.tmp"), left empty if no file was created.
+ *
+ * @return File opened for writing in binary mode.
+ *
+ * @throws std::runtime_error If no file could be created.
+ */
+[[nodiscard]] std::unique_ptr<std::FILE, int (*)(std::FILE *)> create_temp_file(const std::filesystem::path &target_path,
+                                                                                 std::filesystem::path &temp_path)
+{
+    std::random_device random;
+    for (int attempt = 0; attempt < temp_file_attempts; ++attempt) {
+        std::filesystem::path candidate = target_path;
+        candidate += fmt::format(".{:08x}.tmp", random());
+#if defined(_WIN32)
+        std::FILE *file = _wfopen(candidate.c_str(), L"wbx");
+#else
+        std::FILE *file = std::fopen(candidate.c_str(), "wbx");
+#endif
+        if (file != nullptr) {
+            temp_path = std::move(candidate);
+            return {file, &std::fclose};
+        }
+
+        // Error: The directory cannot be written to, another name would not help
+        if (errno != EEXIST) {
+            break;
+        }
+    }
+    throw std::runtime_error("Failed to create a temporary file");
+}
+
+}  // namespace
+
 std::vector<Line> read_lines(const std::filesystem::path &input_path,
                              const std::size_t initial_capacity)
 {
+    const core::stats::ScopedPhase read_phase(core::stats::Phase::Read);
     try {
         // Open the file in read mode
         std::ifstream file(input_path);
@@ -37,9 +93,12 @@ std::vector<Line> read_lines(const std::filesystem::path &input_path,
             std::string buffer;
 
             // Read the file line by line, incrementing the line number
+            std::size_t byte_count = 0;
             while (std::getline(file, buffer)) {
+                byte_count += buffer.size() + 1;
                 lines.emplace_back(Line(++line_number, buffer));
             }
+            core::stats::add_bytes(byte_count);
         }  // Deallocate buffer
 
         // Return shrunk vector (RVO)
@@ -51,4 +110,131 @@ std::vector<Line> read_lines(const std::filesystem::path &input_path,
     }
 }
 
+void LineReader::load(const std::filesystem::path &input_path)
+{
+    const core::stats::ScopedPhase read_phase(core::stats::Phase::Read);
+    this->text_.clear();
+    this->starts_.clear();
+    try {
+        // Open the file unbuffered, the whole file is read with a single call, so the stream's own buffer would only cost an allocation
+        std::ifstream file;
+        file.rdbuf()->pubsetbuf(nullptr, 0);
+        file.open(input_path, std::ios::binary);
+
+        // Error: File cannot be opened
+        if (!file) {
+            throw std::runtime_error("Failed to open file for reading");
+        }
+
+        // Read into the text buffer, which keeps its capacity from the previous file
+        file.seekg(0, std::ios::end);
+        const std::streamoff size = file.tellg();
+        if (size < 0) {
+            throw std::runtime_error("Failed to determine file size");
+        }
+        file.seekg(0, std::ios::beg);
+        this->text_.resize(static_cast<std::size_t>(size));
+        file.read(this->text_.data(), static_cast<std::streamsize>(size));
+
+        // Error: Reading stopped before the end of the file
+        if (!file) {
+            throw std::runtime_error("Failed to read file");
+        }
+    }
+    catch (const std::exception &e) {
+        throw std::runtime_error(fmt::format("Error loading file '{}': {}", input_path.string(), e.what()));
+    }
+
+    // Split at each line feed, a last line without one counts as a line too, but an empty remainder does not
+    std::size_t start = 0;
+    while (start < this->text_.size()) {
+        this->starts_.emplace_back(start);
+        const std::size_t end = this->text_.find('\n', start);
+        start = end == std::string::npos ? this->text_.size() + 1 : end + 1;
+    }
+    this->starts_.emplace_back(start);
+
+    // Count the bytes like "read_lines" does, i.e., each line with its line ending
+    core::stats::add_bytes(start);
+}
+
+std::size_t LineReader::size() const
+{
+    return this->starts_.empty() ? 0 : this->starts_.size() - 1;
+}
+
+std::string_view LineReader::get(const std::size_t number) const
+{
+    const std::size_t start = this->starts_[number - 1];
+    std::size_t length = this->starts_[number] - start - 1;
+#if defined(_WIN32)
+    // The file is read in binary mode, drop the carriage return that text mode would have translated away
+    if (length > 0 && this->text_[start + length - 1] == '\r') {
+        --length;
+    }
+#endif
+    return std::string_view(this->text_).substr(start, length);
+}
+
+std::string read_text(const std::filesystem::path &input_path)
+{
+    try {
+        // Open the file in binary mode, so that line endings are preserved
+        std::ifstream file(input_path, std::ios::binary);
+
+        // Error: File cannot be opened
+        if (!file) {
+            throw std::runtime_error("Failed to open file for reading");
+        }
+
+        // Size the buffer from the file size, so that the file is read with a single call
+        file.seekg(0, std::ios::end);
+        const std::streamoff size = file.tellg();
+        if (size < 0) {
+            throw std::runtime_error("Failed to determine file size");
+        }
+        file.seekg(0, std::ios::beg);
+        std::string text(static_cast<std::size_t>(size), '\0');
+        file.read(text.data(), static_cast<std::streamsize>(size));
+
+        // Error: Reading stopped before the end of the file
+        if (!file) {
+            throw std::runtime_error("Failed to read file");
+        }
+        return text;
+    }
+    catch (const std::exception &e) {
+        throw std::runtime_error(fmt::format("Error loading file '{}': {}", input_path.string(), e.what()));
+    }
+}
+
+void write_text_atomically(const std::filesystem::path &output_path,
+                           const std::string &text)
+{
+    std::filesystem::path temp_path;
+    try {
+        // Replace the file that a symbolic link points to, rather than the link itself, and keep the permissions of the replaced file
+        const bool exists = std::filesystem::exists(output_path);
+        const std::filesystem::path target_path = exists ? std::filesystem::canonical(output_path) : output_path;
+
+        // Write next to the target, so that the rename never crosses file systems
+        auto file = create_temp_file(target_path, temp_path);
+        if (std::fwrite(text.data(), 1, text.size(), file.get()) != text.size() || std::fclose(file.release()) != 0) {
+            throw std::runtime_error("Failed to write file");
+        }
+        if (exists) {
+            std::filesystem::permissions(temp_path, std::filesystem::status(target_path).permissions());
+        }
+        std::filesystem::rename(temp_path, target_path);
+    }
+    catch (const std::exception &e) {
+        // Remove only a temporary file that was created here, using the non-throwing overload, so that a failed cleanup does not replace the original error
+        if (!temp_path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+        }
+        throw std::runtime_error(fmt::format("Error saving file '{}': {}", output_path.string(), e.what()));
+    }
+}
+
 }  // namespace core::io
@@ -6,10 +6,11 @@
 
 #pragma once
 
-#include <cstddef>     // for std::size_t
-#include <filesystem>  // for std::filesystem
-#include <string>      // for std::string
-#include <vector>      // for std::vector
+#include <cstddef>      // for std::size_t
+#include <filesystem>   // for std::filesystem
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
 
 namespace core::io {
 
@@ -54,4 +55,75 @@ struct Line {
 [[nodiscard]] std::vector<Line> read_lines(const std::filesystem::path &input_path,
                                            const std::size_t initial_capacity = 100);
 
+/**
+ * @brief Class that loads text files line by line into buffers that are reused from file to file.
+ *
+ * Unlike "read_lines", the lines are views into a single buffer, so loading a file does not allocate per line. Once the buffers have grown to fit a typical file, loading another file does not allocate at all.
+ *
+ * @note This class is marked as `final` to prevent inheritance. The lines are split like "std::getline" splits them, and the views are only valid until the next call to "load".
+ */
+class LineReader final {
+  public:
+    /**
+     * @brief Load a text file from disk, replacing the previously loaded file.
+     *
+     * @param input_path Path to the text file (e.g., "~/data.txt").
+     *
+     * @throws std::runtime_error If the file cannot be opened for reading or if any other I/O error occurs.
+     */
+    void load(const std::filesystem::path &input_path);
+
+    /**
+     * @brief Get the number of lines of the loaded file.
+     *
+     * @return Number of lines (e.g., "2").
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Get a line of the loaded file.
+     *
+     * @param number Line number, starting at 1 and at most "size()" (e.g., "1").
+     *
+     * @return View of the line text, without the line ending (e.g., "Hello world!").
+     */
+    [[nodiscard]] std::string_view get(const std::size_t number) const;
+
+  private:
+    /**
+     * @brief Contents of the loaded file.
+     */
+    std::string text_;
+
+    /**
+     * @brief Offset of the first character of each line, followed by the offset one past the last line's line ending.
+     */
+    std::vector<std::size_t> starts_;
+};
+
+/**
+ * @brief Load the entire contents of a text file from disk, byte for byte.
+ *
+ * @param input_path Path to the text file (e.g., "~/data.txt").
+ *
+ * @return Contents of the file, including line endings (e.g., "Hello world!\nHow are you?\n").
+ *
+ * @throws std::runtime_error If the file cannot be opened for reading or if any other I/O error occurs.
+ */
+[[nodiscard]] std::string read_text(const std::filesystem::path &input_path);
+
+/**
+ * @brief Replace the contents of a text file on disk atomically.
+ *
+ * The text is written byte for byte to a temporary file with a unique name next to the target, which is then renamed over the target, so that other processes never observe a partially written file.
+ * The replaced file keeps its permissions, and a symbolic link is kept as well, the file it points to is replaced instead.
+ *
+ * @param output_path Path to the text file (e.g., "~/data.txt").
+ * @param text New contents of the file, which may also be binary (e.g., "Hello world!\n").
+ *
+ * @throws std::runtime_error If the temporary file cannot be written or renamed. The target is left untouched in that case.
+ */
+void write_text_atomically(const std::filesystem::path &output_path,
+                           const std::string &text);
+
 }  // namespace core::io
@@ -0,0 +1,85 @@
+/**
+ * @file mmap.cpp
+ */
+
+#include <cstddef>     // for std::size_t
+#include <filesystem>  // for std::filesystem
+#include <stdexcept>   // for std::runtime_error
+
+#include <fmt/core.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN  // Exclude rarely-used stuff from Windows headers
+#include <windows.h>         // for CreateFileW, CreateFileMappingW, MapViewOfFile, UnmapViewOfFile, CloseHandle
+#else
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap, MAP_FAILED
+#include <unistd.h>    // for close
+#endif
+
+#include "mmap.hpp"
+
+namespace core::mmap {
+
+MappedFile::MappedFile(const std::filesystem::path &input_path)
+    : size_(static_cast<std::size_t>(std::filesystem::file_size(input_path)))
+{
+    // An empty file cannot be mapped, but it is still a valid (empty) file
+    if (this->size_ == 0) {
+        return;
+    }
+
+#if defined(_WIN32)
+    const HANDLE file = CreateFileW(input_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(fmt::format("Failed to open file for mapping: {}", input_path.string()));
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        throw std::runtime_error(fmt::format("Failed to map file: {}", input_path.string()));
+    }
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    // The view keeps the mapping alive, so the handle can be closed right away
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        throw std::runtime_error(fmt::format("Failed to map file: {}", input_path.string()));
+    }
+    this->data_ = static_cast<const char *>(view);
+#else
+    const int file = open(input_path.c_str(), O_RDONLY);
+    if (file == -1) {
+        throw std::runtime_error(fmt::format("Failed to open file for mapping: {}", input_path.string()));
+    }
+    void *view = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps the file alive, so the descriptor can be closed right away
+    close(file);
+    if (view == MAP_FAILED) {
+        throw std::runtime_error(fmt::format("Failed to map file: {}", input_path.string()));
+    }
+    this->data_ = static_cast<const char *>(view);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    if (this->data_ == nullptr) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(this->data_);
+#else
+    ::munmap(const_cast<char *>(this->data_), this->size_);
+#endif
+}
+
+const char *MappedFile::data() const
+{
+    return this->data_;
+}
+
+std::size_t MappedFile::size() const
+{
+    return this->size_;
+}
+
+}  // namespace core::mmap
@@ -0,0 +1,68 @@
+/**
+ * @file mmap.hpp
+ *
+ * @brief Map files into memory for read-only access.
+ */
+
+#pragma once
+
+#include <cstddef>     // for std::size_t
+#include <filesystem>  // for std::filesystem
+
+namespace core::mmap {
+
+/**
+ * @brief Class that represents a read-only memory-mapped file as a RAII object.
+ *
+ * On construction, the whole file is mapped into memory. When the object goes out of scope, the file is unmapped.
+ *
+ * @note This class is marked as `final` to prevent inheritance. It is neither copyable nor movable.
+ */
+class MappedFile final {
+  public:
+    /**
+     * @brief Construct a new MappedFile object.
+     *
+     * @param input_path Path to the file that shall be mapped (e.g., "~/header-warden.idx").
+     *
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path &input_path);
+
+    /**
+     * @brief Destroy the MappedFile object.
+     *
+     * On destruction, the file is unmapped.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Get a pointer to the first byte of the mapped file.
+     *
+     * @return Pointer to the mapped memory, or nullptr if the file is empty.
+     */
+    [[nodiscard]] const char *data() const;
+
+    /**
+     * @brief Get the size of the mapped file.
+     *
+     * @return Size in bytes (e.g., "4096").
+     */
+    [[nodiscard]] std::size_t size() const;
+
+  private:
+    /**
+     * @brief Pointer to the mapped memory, or nullptr if the file is empty.
+     */
+    const char *data_ = nullptr;
+
+    /**
+     * @brief Size of the mapped file in bytes.
+     */
+    std::size_t size_ = 0;
+};
+
+}  // namespace core::mmap
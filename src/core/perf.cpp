@@ -0,0 +1,188 @@
+/**
+ * @file perf.cpp
+ */
+
+#include <array>    // for std::array
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <string>   // for std::string
+#include <utility>  // for std::pair
+
+#include "perf.hpp"
+
+#if defined(__linux__)
+#include <cerrno>              // for errno
+#include <cstring>             // for std::strerror
+#include <linux/perf_event.h>  // for perf_event_attr, PERF_*
+#include <sys/ioctl.h>         // for ioctl
+#include <sys/syscall.h>       // for SYS_perf_event_open
+#include <unistd.h>            // for syscall, read, close
+#endif
+
+namespace core::perf {
+
+namespace {
+
+#if defined(__linux__)
+
+/**
+ * @brief Private helper function to open a counter for the calling thread.
+ *
+ * @param type Type of the event (e.g., "PERF_TYPE_HARDWARE").
+ * @param config Event within the type (e.g., "PERF_COUNT_HW_CPU_CYCLES").
+ * @param group_fd File descriptor of the group leader, or -1 to open a new group.
+ *
+ * @return File descriptor of the counter, or -1 if it could not be opened (errno is set).
+ */
+int open_counter(const std::uint32_t type,
+                 const std::uint64_t config,
+                 const int group_fd)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    // Only user space is counted, which is also all that "perf_event_paranoid" level 2 allows
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // The leader starts disabled, so that all members start counting at the same time
+    attr.disabled = group_fd == -1 ? 1 : 0;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // pid 0 and cpu -1 count the calling thread on any CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0UL));
+}
+
+#endif
+
+}  // namespace
+
+const char *get_event_name(const Event event)
+{
+    switch (event) {
+    case Event::Cycles:
+        return "cycles";
+    case Event::Instructions:
+        return "instructions";
+    case Event::BranchMisses:
+        return "branch-misses";
+    case Event::LlcMisses:
+        return "llc-misses";
+    }
+    return "unknown";
+}
+
+Sample &Sample::operator+=(const Sample &other)
+{
+    for (std::size_t i = 0; i < event_count; ++i) {
+        this->values[i] += other.values[i];
+    }
+    return *this;
+}
+
+Sample Sample::operator-(const Sample &earlier) const
+{
+    Sample difference;
+    for (std::size_t i = 0; i < event_count; ++i) {
+        // Scaling multiplexed counters is an estimate, so a later value can be slightly lower
+        difference.values[i] = this->values[i] > earlier.values[i] ? this->values[i] - earlier.values[i] : 0;
+    }
+    return difference;
+}
+
+CounterGroup::CounterGroup()
+    : fds_{-1, -1, -1, -1}
+{
+#if defined(__linux__)
+    // Last-level cache read misses, as "perf" calls "LLC-load-misses"
+    constexpr std::uint64_t llc_read_misses = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const std::array<std::pair<std::uint32_t, std::uint64_t>, event_count> events = {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, llc_read_misses},
+    }};
+
+    // The cycle counter leads the group, without it nothing is counted
+    this->fds_[0] = open_counter(events[0].first, events[0].second, -1);
+    if (this->fds_[0] == -1) {
+        const int error = errno;
+        this->error_ = std::string("perf_event_open: ") + std::strerror(error);
+        // Explain the two common causes, since the raw messages are not helpful
+        if (error == EACCES || error == EPERM) {
+            this->error_ += ", check \"/proc/sys/kernel/perf_event_paranoid\"";
+        }
+        else if (error == ENOENT || error == ENODEV || error == EOPNOTSUPP) {
+            this->error_ += ", the CPU or virtual machine exposes no hardware counters";
+        }
+        return;
+    }
+    // Members that cannot be opened are skipped, e.g., cache events in virtual machines
+    for (std::size_t i = 1; i < event_count; ++i) {
+        this->fds_[i] = open_counter(events[i].first, events[i].second, this->fds_[0]);
+    }
+    ioctl(this->fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(this->fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    this->error_ = "hardware counters are only supported on Linux";
+#endif
+}
+
+CounterGroup::~CounterGroup()
+{
+#if defined(__linux__)
+    // Close the members before the leader
+    for (std::size_t i = event_count; i-- > 0;) {
+        if (this->fds_[i] != -1) {
+            close(this->fds_[i]);
+        }
+    }
+#endif
+}
+
+bool CounterGroup::is_available() const
+{
+    return this->fds_[0] != -1;
+}
+
+bool CounterGroup::is_supported(const Event event) const
+{
+    return this->fds_[static_cast<std::size_t>(event)] != -1;
+}
+
+const std::string &CounterGroup::get_error() const
+{
+    return this->error_;
+}
+
+Sample CounterGroup::read() const
+{
+    Sample sample;
+#if defined(__linux__)
+    if (!this->is_available()) {
+        return sample;
+    }
+
+    // Layout of a group read: number of values, time enabled, time running, then one value per opened counter, in the order they were opened
+    std::array<std::uint64_t, 3 + event_count> buffer{};
+    const auto bytes = ::read(this->fds_[0], buffer.data(), sizeof(buffer));
+    if (bytes < static_cast<long>(3 * sizeof(std::uint64_t))) {
+        return sample;
+    }
+    const std::uint64_t count = buffer[0];
+    const std::uint64_t enabled = buffer[1];
+    const std::uint64_t running = buffer[2];
+
+    // Scale up if the counters were multiplexed with other events, this is what "perf stat" does too
+    const double scale = running == 0 ? 0.0 : static_cast<double>(enabled) / static_cast<double>(running);
+    std::size_t value_index = 0;
+    for (std::size_t i = 0; i < event_count && value_index < count; ++i) {
+        if (this->fds_[i] != -1) {
+            sample.values[i] = static_cast<std::uint64_t>(static_cast<double>(buffer[3 + value_index]) * scale);
+            ++value_index;
+        }
+    }
+#endif
+    return sample;
+}
+
+}  // namespace core::perf
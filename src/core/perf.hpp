@@ -0,0 +1,134 @@
+/**
+ * @file perf.hpp
+ *
+ * @brief Read hardware performance counters of the calling thread, using "perf_event_open" on Linux.
+ */
+
+#pragma once
+
+#include <array>    // for std::array
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <string>   // for std::string
+
+namespace core::perf {
+
+/**
+ * @brief Enum that represents a hardware event.
+ */
+enum class Event : std::size_t {
+    Cycles,        // CPU cycles, excluding the kernel
+    Instructions,  // Retired instructions, excluding the kernel
+    BranchMisses,  // Mispredicted branches
+    LlcMisses      // Last-level cache read misses
+};
+
+/**
+ * @brief Number of events in the Event enum.
+ */
+inline constexpr std::size_t event_count = 4;
+
+/**
+ * @brief Get the name of an event.
+ *
+ * @param event Event to get the name of (e.g., "Event::BranchMisses").
+ *
+ * @return Lowercase name of the event, as used by the "perf" tool (e.g., "branch-misses").
+ */
+[[nodiscard]] const char *get_event_name(const Event event);
+
+/**
+ * @brief Struct that represents the values of all events at a point in time, or the difference between two such points.
+ */
+struct Sample final {
+    /**
+     * @brief Value of each event, indexed by Event.
+     */
+    std::array<std::uint64_t, event_count> values{};
+
+    /**
+     * @brief Add the values of another sample to this one.
+     *
+     * @param other Sample to add.
+     *
+     * @return Reference to this sample.
+     */
+    Sample &operator+=(const Sample &other);
+
+    /**
+     * @brief Get the difference between this sample and an earlier one.
+     *
+     * @param earlier Sample taken earlier on the same counters.
+     *
+     * @return Difference of each event, zero where the counter went backwards.
+     */
+    [[nodiscard]] Sample operator-(const Sample &earlier) const;
+};
+
+/**
+ * @brief Class that represents a group of hardware counters for the calling thread.
+ *
+ * The counters are opened on construction and count only while the thread runs in user space. If the platform or the kernel does not allow it (e.g., "perf_event_paranoid" is too strict, or the machine is virtualized without a PMU), the group is simply not available, and reading it returns zeros.
+ *
+ * @note This class is marked as `final` to prevent inheritance. It must only be read on the thread that created it.
+ */
+class CounterGroup final {
+  public:
+    /**
+     * @brief Construct a new CounterGroup object and start counting on the calling thread.
+     */
+    CounterGroup();
+
+    /**
+     * @brief Destroy the CounterGroup object and close the counters.
+     */
+    ~CounterGroup();
+
+    CounterGroup(const CounterGroup &) = delete;
+    CounterGroup &operator=(const CounterGroup &) = delete;
+
+    /**
+     * @brief Check if the counters could be opened.
+     *
+     * @return True if at least the cycle counter is available, false otherwise.
+     */
+    [[nodiscard]] bool is_available() const;
+
+    /**
+     * @brief Check if a single event could be opened, e.g., some virtual machines count cycles but not cache misses.
+     *
+     * @param event Event to check (e.g., "Event::LlcMisses").
+     *
+     * @return True if the event is counted, false otherwise.
+     */
+    [[nodiscard]] bool is_supported(const Event event) const;
+
+    /**
+     * @brief Get the reason why the counters are not available.
+     *
+     * @return Human-readable reason (e.g., "perf_event_open: Permission denied"), or an empty string if they are available.
+     */
+    [[nodiscard]] const std::string &get_error() const;
+
+    /**
+     * @brief Read the current values of all events with a single system call.
+     *
+     * The values are scaled up if the kernel had to multiplex the counters, i.e., if they were not running all the time.
+     *
+     * @return Current values, all zero if the counters are not available.
+     */
+    [[nodiscard]] Sample read() const;
+
+  private:
+    /**
+     * @brief File descriptor of each event, indexed by Event, or -1 if the event could not be opened. The first one leads the group.
+     */
+    std::array<int, event_count> fds_;
+
+    /**
+     * @brief Reason why the counters are not available, empty if they are.
+     */
+    std::string error_;
+};
+
+}  // namespace core::perf
@@ -0,0 +1,548 @@
+/**
+ * @file stats.cpp
+ */
+
+#include <algorithm>   // for std::clamp, std::max, std::min, std::push_heap, std::pop_heap, std::sort
+#include <array>       // for std::array
+#include <atomic>      // for std::atomic, std::memory_order_relaxed
+#include <chrono>      // for std::chrono
+#include <cmath>       // for std::ceil
+#include <cstddef>     // for std::size_t, std::ptrdiff_t
+#include <cstdint>     // for std::uint64_t
+#include <cstdlib>     // for std::malloc, std::free
+#include <filesystem>  // for std::filesystem
+#include <list>        // for std::list
+#include <mutex>       // for std::mutex, std::lock_guard
+#include <new>         // for std::bad_alloc
+#include <optional>    // for std::optional, std::nullopt
+#include <string>      // for std::string
+#include <vector>      // for std::vector
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>  // for getrusage, rusage, RUSAGE_SELF
+#endif
+
+#include "perf.hpp"
+#include "stats.hpp"
+
+namespace core::stats {
+
+namespace {
+
+/**
+ * @brief Private helper struct that represents the statistics of a single thread.
+ */
+struct ThreadStats final {
+    /**
+     * @brief Time spent in each phase, indexed by Phase.
+     */
+    std::array<std::chrono::nanoseconds, phase_count> phases{};
+
+    /**
+     * @brief Number of times each phase was entered, indexed by Phase.
+     */
+    std::array<std::size_t, phase_count> entries{};
+
+    /**
+     * @brief Number of processed files.
+     */
+    std::size_t files = 0;
+
+    /**
+     * @brief Number of bytes read from disk.
+     */
+    std::size_t bytes = 0;
+
+    /**
+     * @brief Time spent on processed files.
+     */
+    std::chrono::nanoseconds busy{0};
+
+    /**
+     * @brief Latencies of the processed files.
+     */
+    Histogram latency;
+
+    /**
+     * @brief Slowest files of this thread, as a min-heap on time, so the fastest of them is replaced first.
+     */
+    std::vector<FileTime> slowest;
+
+    /**
+     * @brief Phase the thread is currently in, or "phase_count" if there is none.
+     */
+    std::size_t current = phase_count;
+
+    /**
+     * @brief Time at which the current phase was entered or resumed.
+     */
+    std::chrono::steady_clock::time_point since;
+
+    /**
+     * @brief Number of allocations in each phase, indexed by Phase, the last element counts allocations outside of any phase.
+     */
+    std::array<std::size_t, phase_count + 1> allocations{};
+
+    /**
+     * @brief Number of bytes allocated in each phase, indexed like "allocations".
+     */
+    std::array<std::size_t, phase_count + 1> allocated_bytes{};
+
+    /**
+     * @brief Total number of allocations, used to measure the allocations of a single file.
+     */
+    std::size_t total_allocations = 0;
+
+    /**
+     * @brief Total number of allocated bytes, used to measure the allocations of a single file.
+     */
+    std::size_t total_bytes = 0;
+
+    /**
+     * @brief Files of this thread with the most allocated bytes, as a min-heap on bytes.
+     */
+    std::vector<FileAllocations> top_allocating;
+
+    /**
+     * @brief Hardware counters of the thread, opened when the thread records for the first time.
+     */
+    core::perf::CounterGroup counters;
+
+    /**
+     * @brief Values of the hardware counters when the current phase was entered or resumed.
+     */
+    core::perf::Sample counted_since;
+
+    /**
+     * @brief Hardware events counted in each phase, indexed by Phase.
+     */
+    std::array<core::perf::Sample, phase_count> events{};
+};
+
+/**
+ * @brief Statistics of the calling thread, or nullptr if it has not recorded yet.
+ *
+ * This is a plain pointer rather than a thread-local object, so that "operator new" can read it without allocating or running constructors.
+ */
+thread_local ThreadStats *local_stats = nullptr;
+
+/**
+ * @brief Private helper function to compare files by time, so that the standard heap functions build a min-heap.
+ */
+bool is_slower(const FileTime &lhs,
+               const FileTime &rhs)
+{
+    return lhs.elapsed > rhs.elapsed;
+}
+
+/**
+ * @brief Private helper function to compare files by allocated bytes, so that the standard heap functions build a min-heap.
+ */
+bool allocates_more(const FileAllocations &lhs,
+                    const FileAllocations &rhs)
+{
+    return lhs.bytes > rhs.bytes;
+}
+
+/**
+ * @brief If true, statistics are collected.
+ */
+std::atomic<bool> collecting{false};
+
+/**
+ * @brief Mutex that protects the registry. It is only locked once per thread, when the thread records for the first time.
+ */
+std::mutex registry_mutex;
+
+/**
+ * @brief Statistics of all threads that have recorded so far. A list is used, so that the elements never move.
+ */
+std::list<ThreadStats> registry;
+
+/**
+ * @brief Private helper function to get the statistics of the calling thread, registering them on first use.
+ *
+ * @return Reference to the statistics of the calling thread.
+ */
+ThreadStats &get_local()
+{
+    if (local_stats == nullptr) {
+        // The allocation of the new element is not counted, since the pointer is only set afterwards
+        const std::lock_guard<std::mutex> lock(registry_mutex);
+        local_stats = &registry.emplace_back();
+    }
+    return *local_stats;
+}
+
+/**
+ * @brief Private helper function to charge the time since the last switch to the current phase, and restart the clock.
+ *
+ * @param local Statistics of the calling thread.
+ */
+void charge(ThreadStats &local)
+{
+    const auto now = std::chrono::steady_clock::now();
+    // Unavailable counters read as zero without a system call
+    const auto sample = local.counters.read();
+    if (local.current != phase_count) {
+        local.phases[local.current] += now - local.since;
+        local.events[local.current] += sample - local.counted_since;
+    }
+    local.since = now;
+    local.counted_since = sample;
+}
+
+}  // namespace
+
+const char *get_phase_name(const Phase phase)
+{
+    switch (phase) {
+    case Phase::Traverse:
+        return "traverse";
+    case Phase::Read:
+        return "read";
+    case Phase::Parse:
+        return "parse";
+    case Phase::Report:
+        return "report";
+    }
+    return "unknown";
+}
+
+void set_enabled(const bool enabled)
+{
+    collecting.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_enabled()
+{
+    return collecting.load(std::memory_order_relaxed);
+}
+
+void reset()
+{
+    const std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto &local : registry) {
+        // Keep the current phase, so that a phase that is still open on this thread is charged from now on
+        local.phases = {};
+        local.entries = {};
+        local.files = 0;
+        local.bytes = 0;
+        local.busy = std::chrono::nanoseconds{0};
+        local.latency = {};
+        local.slowest.clear();
+        local.since = std::chrono::steady_clock::now();
+        local.allocations = {};
+        local.allocated_bytes = {};
+        local.top_allocating.clear();
+        local.counted_since = local.counters.read();
+        local.events = {};
+    }
+}
+
+ScopedPhase::ScopedPhase(const Phase phase)
+    : span_(get_phase_name(phase)),
+      active_(is_enabled()),
+      previous_(phase_count)
+{
+    if (!this->active_) {
+        return;
+    }
+    auto &local = get_local();
+    charge(local);
+    this->previous_ = local.current;
+    local.current = static_cast<std::size_t>(phase);
+    ++local.entries[local.current];
+}
+
+ScopedPhase::~ScopedPhase()
+{
+    if (!this->active_) {
+        return;
+    }
+    auto &local = get_local();
+    charge(local);
+    local.current = this->previous_;
+}
+
+void Histogram::record(const std::chrono::nanoseconds value)
+{
+    const std::uint64_t ns = value.count() > 0 ? static_cast<std::uint64_t>(value.count()) : 0;
+    ++this->buckets_[get_index(ns)];
+    ++this->count_;
+    this->max_ = std::max(this->max_, ns);
+}
+
+void Histogram::merge(const Histogram &other)
+{
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        this->buckets_[i] += other.buckets_[i];
+    }
+    this->count_ += other.count_;
+    this->max_ = std::max(this->max_, other.max_);
+}
+
+std::size_t Histogram::get_count() const
+{
+    return this->count_;
+}
+
+std::chrono::nanoseconds Histogram::get_percentile(const double percentile) const
+{
+    if (this->count_ == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    // The percentile is the smallest latency with at least "rank" latencies at or below it, e.g., p50 of 15 latencies is the 8th
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max<std::size_t>(static_cast<std::size_t>(std::ceil(clamped / 100.0 * static_cast<double>(this->count_))), 1);
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        seen += this->buckets_[i];
+        if (seen >= rank) {
+            return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(std::min(get_upper_bound(i), this->max_))};
+        }
+    }
+    return this->get_max();
+}
+
+std::chrono::nanoseconds Histogram::get_max() const
+{
+    return std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(this->max_)};
+}
+
+std::size_t Histogram::get_index(const std::uint64_t value)
+{
+    if (value < sub_bucket_count) {
+        return static_cast<std::size_t>(value);
+    }
+    // Find the highest set bit, the bits below it select the sub-bucket
+    unsigned exponent = sub_bucket_bits;
+    while ((value >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    const auto sub_bucket = static_cast<std::size_t>((value >> (exponent - sub_bucket_bits)) & (sub_bucket_count - 1));
+    return (exponent - sub_bucket_bits + 1) * sub_bucket_count + sub_bucket;
+}
+
+std::uint64_t Histogram::get_upper_bound(const std::size_t index)
+{
+    if (index < sub_bucket_count) {
+        return index;
+    }
+    const std::size_t exponent = index / sub_bucket_count + sub_bucket_bits - 1;
+    const std::size_t shift = exponent - sub_bucket_bits;
+    const std::uint64_t lower = static_cast<std::uint64_t>(sub_bucket_count + index % sub_bucket_count) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void add_bytes(const std::size_t bytes)
+{
+    if (is_enabled()) {
+        get_local().bytes += bytes;
+    }
+}
+
+void add_file(const std::string &path,
+              const std::chrono::nanoseconds elapsed,
+              const std::size_t allocations,
+              const std::size_t allocated_bytes)
+{
+    if (!is_enabled()) {
+        return;
+    }
+    auto &local = get_local();
+    ++local.files;
+    local.busy += elapsed;
+    local.latency.record(elapsed);
+
+    // Keep only the slowest files, the path is copied only if the file is among them
+    if (local.slowest.size() < slowest_file_count) {
+        local.slowest.push_back({path, elapsed});
+        std::push_heap(local.slowest.begin(), local.slowest.end(), is_slower);
+    }
+    else if (elapsed > local.slowest.front().elapsed) {
+        std::pop_heap(local.slowest.begin(), local.slowest.end(), is_slower);
+        local.slowest.back() = {path, elapsed};
+        std::push_heap(local.slowest.begin(), local.slowest.end(), is_slower);
+    }
+
+    // Keep only the files with the most allocated bytes, in the same way
+    if constexpr (alloc_tracking) {
+        if (local.top_allocating.size() < slowest_file_count) {
+            local.top_allocating.push_back({path, allocations, allocated_bytes});
+            std::push_heap(local.top_allocating.begin(), local.top_allocating.end(), allocates_more);
+        }
+        else if (allocated_bytes > local.top_allocating.front().bytes) {
+            std::pop_heap(local.top_allocating.begin(), local.top_allocating.end(), allocates_more);
+            local.top_allocating.back() = {path, allocations, allocated_bytes};
+            std::push_heap(local.top_allocating.begin(), local.top_allocating.end(), allocates_more);
+        }
+    }
+}
+
+ScopedFile::ScopedFile(const std::filesystem::path &path)
+    : path_(path),
+      active_(is_enabled()),
+      start_(this->active_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}),
+      start_allocations_(0),
+      start_bytes_(0)
+{
+    if (alloc_tracking && this->active_) {
+        const auto &local = get_local();
+        this->start_allocations_ = local.total_allocations;
+        this->start_bytes_ = local.total_bytes;
+    }
+}
+
+ScopedFile::~ScopedFile()
+{
+    if (this->active_) {
+        // Take the counts before the path is converted, so that the conversion is not charged to the file
+        const auto elapsed = std::chrono::steady_clock::now() - this->start_;
+        const auto &local = get_local();
+        const std::size_t allocations = local.total_allocations - this->start_allocations_;
+        const std::size_t allocated_bytes = local.total_bytes - this->start_bytes_;
+        add_file(this->path_.string(), elapsed, alloc_tracking ? allocations : 0, alloc_tracking ? allocated_bytes : 0);
+    }
+}
+
+Summary collect()
+{
+    Summary summary{{}, {}, 0, 0, {}, {}, {}, {}, {}, {}, {}, {}, {}};
+    const std::lock_guard<std::mutex> lock(registry_mutex);
+    summary.counted.fill(!registry.empty());
+    for (const auto &local : registry) {
+        // An event is only reported if every thread counted it, otherwise the sums would be misleading
+        if (!local.counters.is_available() && summary.counters_error.empty()) {
+            summary.counters_error = local.counters.get_error();
+        }
+        for (std::size_t i = 0; i < core::perf::event_count; ++i) {
+            summary.counted[i] = summary.counted[i] && local.counters.is_supported(static_cast<core::perf::Event>(i));
+        }
+        for (std::size_t i = 0; i < phase_count; ++i) {
+            summary.events[i] += local.events[i];
+        }
+        for (std::size_t i = 0; i < phase_count; ++i) {
+            summary.phases[i] += local.phases[i];
+            summary.entries[i] += local.entries[i];
+        }
+        summary.files += local.files;
+        summary.bytes += local.bytes;
+        if (local.files != 0) {
+            summary.busy.emplace_back(local.busy);
+        }
+        summary.latency.merge(local.latency);
+        summary.slowest.insert(summary.slowest.cend(), local.slowest.cbegin(), local.slowest.cend());
+        for (std::size_t i = 0; i <= phase_count; ++i) {
+            summary.allocations[i] += local.allocations[i];
+            summary.allocated_bytes[i] += local.allocated_bytes[i];
+        }
+        summary.top_allocating.insert(summary.top_allocating.cend(), local.top_allocating.cbegin(), local.top_allocating.cend());
+    }
+
+    // Sort the slowest files of all threads by time in descending order, then by path, so that ties are deterministic
+    std::sort(summary.slowest.begin(), summary.slowest.end(), [](const FileTime &lhs, const FileTime &rhs) {
+        return lhs.elapsed != rhs.elapsed ? lhs.elapsed > rhs.elapsed : lhs.path < rhs.path;
+    });
+    if (summary.slowest.size() > slowest_file_count) {
+        summary.slowest.erase(summary.slowest.cbegin() + static_cast<std::ptrdiff_t>(slowest_file_count), summary.slowest.cend());
+    }
+
+    // Sort the most allocating files of all threads in the same way
+    std::sort(summary.top_allocating.begin(), summary.top_allocating.end(), [](const FileAllocations &lhs, const FileAllocations &rhs) {
+        return lhs.bytes != rhs.bytes ? lhs.bytes > rhs.bytes : lhs.path < rhs.path;
+    });
+    if (summary.top_allocating.size() > slowest_file_count) {
+        summary.top_allocating.erase(summary.top_allocating.cbegin() + static_cast<std::ptrdiff_t>(slowest_file_count), summary.top_allocating.cend());
+    }
+    return summary;
+}
+
+std::optional<std::size_t> get_peak_rss()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0) {
+        return std::nullopt;
+    }
+#if defined(__APPLE__)
+    // macOS reports bytes
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+    // Linux and the BSDs report kilobytes
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return std::nullopt;
+#endif
+}
+
+}  // namespace core::stats
+
+#if defined(ENABLE_ALLOC_STATS)
+
+namespace {
+
+/**
+ * @brief Private helper function to allocate memory and count the allocation on the calling thread, in its current phase.
+ *
+ * Threads that have not recorded yet are not counted, since registering them would allocate.
+ *
+ * @param size Number of bytes to allocate (e.g., "64").
+ *
+ * @return Pointer to the allocated memory.
+ *
+ * @throws std::bad_alloc If the memory cannot be allocated.
+ */
+void *counted_allocate(const std::size_t size)
+{
+    core::stats::ThreadStats *const local = core::stats::local_stats;
+    if (local != nullptr && core::stats::is_enabled()) {
+        ++local->allocations[local->current];
+        local->allocated_bytes[local->current] += size;
+        ++local->total_allocations;
+        local->total_bytes += size;
+    }
+    // "malloc(0)" may return nullptr, but "operator new" must return a unique pointer
+    if (void *const pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+}  // namespace
+
+// Replace the global allocation functions, the nothrow variants fall back to these by default
+void *operator new(const std::size_t size)
+{
+    return counted_allocate(size);
+}
+
+void *operator new[](const std::size_t size)
+{
+    return counted_allocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer,
+                     std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer,
+                       std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#endif  // ENABLE_ALLOC_STATS
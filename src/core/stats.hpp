@@ -0,0 +1,411 @@
+/**
+ * @file stats.hpp
+ *
+ * @brief Collect low-overhead runtime statistics, such as the time spent in each phase, the hardware events counted in each phase, and the slowest files.
+ */
+
+#pragma once
+
+#include <array>       // for std::array
+#include <chrono>      // for std::chrono
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint64_t
+#include <filesystem>  // for std::filesystem
+#include <optional>    // for std::optional
+#include <string>      // for std::string
+#include <vector>      // for std::vector
+
+#include "perf.hpp"
+#include "trace.hpp"
+
+namespace core::stats {
+
+/**
+ * @brief Enum that represents a phase of a run.
+ */
+enum class Phase : std::size_t {
+    Traverse,  // Finding the files to analyze
+    Read,      // Loading files from disk
+    Parse,     // Extracting the findings from the loaded lines
+    Report     // Rendering and printing the findings
+};
+
+/**
+ * @brief Number of phases in the Phase enum.
+ */
+inline constexpr std::size_t phase_count = 4;
+
+/**
+ * @brief Maximum number of slowest files kept per thread and in the summary.
+ */
+inline constexpr std::size_t slowest_file_count = 10;
+
+/**
+ * @brief If true, the global "operator new" is replaced to count allocations per phase and per file. Enabled with the "ENABLE_ALLOC_STATS" CMake option, since it adds a thread-local lookup to every allocation.
+ */
+#if defined(ENABLE_ALLOC_STATS)
+inline constexpr bool alloc_tracking = true;
+#else
+inline constexpr bool alloc_tracking = false;
+#endif
+
+/**
+ * @brief Get the name of a phase.
+ *
+ * @param phase Phase to get the name of (e.g., "Phase::Parse").
+ *
+ * @return Lowercase name of the phase (e.g., "parse").
+ */
+[[nodiscard]] const char *get_phase_name(const Phase phase);
+
+/**
+ * @brief Enable or disable the collection of statistics for all threads.
+ *
+ * When disabled, recording is reduced to a single relaxed atomic load, so the instrumentation can stay in place.
+ *
+ * @param enabled If true, statistics are collected from now on.
+ */
+void set_enabled(const bool enabled);
+
+/**
+ * @brief Check if statistics are being collected.
+ *
+ * @return True if enabled, false otherwise.
+ */
+[[nodiscard]] bool is_enabled();
+
+/**
+ * @brief Reset the statistics of all threads to zero.
+ *
+ * @note This must not be called while other threads are recording.
+ */
+void reset();
+
+/**
+ * @brief Class that charges the time of its lifetime to a phase on the calling thread.
+ *
+ * Phases nest: a nested phase pauses the enclosing one, so every nanosecond is charged to exactly one phase (e.g., reading a file inside the parser is charged to "Read" only). Hardware events, if they can be counted, are charged in the same way. If tracing is enabled, the phase is also recorded as a span named after the phase.
+ *
+ * @note This class is marked as `final` to prevent inheritance. It must be destroyed on the thread that created it, in reverse order of creation.
+ */
+class ScopedPhase final {
+  public:
+    /**
+     * @brief Construct a new ScopedPhase object and enter the phase, if statistics are enabled.
+     *
+     * @param phase Phase to enter (e.g., "Phase::Parse").
+     */
+    explicit ScopedPhase(const Phase phase);
+
+    /**
+     * @brief Destroy the ScopedPhase object and return to the enclosing phase.
+     */
+    ~ScopedPhase();
+
+    ScopedPhase(const ScopedPhase &) = delete;
+    ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+  private:
+    /**
+     * @brief Span of the phase, recorded if tracing is enabled.
+     */
+    const core::trace::ScopedSpan span_;
+
+    /**
+     * @brief If true, statistics were enabled on construction, so the destructor has to leave the phase.
+     */
+    bool active_;
+
+    /**
+     * @brief Index of the enclosing phase, or "phase_count" if there is none.
+     */
+    std::size_t previous_;
+};
+
+/**
+ * @brief Count bytes read from disk on the calling thread.
+ *
+ * @param bytes Number of bytes (e.g., "1024").
+ */
+void add_bytes(const std::size_t bytes);
+
+/**
+ * @brief Count a processed file on the calling thread. The time is counted as busy time of the thread and recorded in its latency histogram.
+ *
+ * @param path Path to the file (e.g., "~/src/app.cpp").
+ * @param elapsed Time spent on the file.
+ * @param allocations Number of allocations made while processing the file (e.g., "1200"), always 0 if allocations are not tracked.
+ * @param allocated_bytes Number of bytes allocated while processing the file (e.g., "65536"), always 0 if allocations are not tracked.
+ */
+void add_file(const std::string &path,
+              const std::chrono::nanoseconds elapsed,
+              const std::size_t allocations = 0,
+              const std::size_t allocated_bytes = 0);
+
+/**
+ * @brief Class that counts a processed file when it goes out of scope, with the time of its lifetime, if statistics are enabled.
+ *
+ * @note This class is marked as `final` to prevent inheritance. It must be destroyed on the thread that created it.
+ */
+class ScopedFile final {
+  public:
+    /**
+     * @brief Construct a new ScopedFile object and start the clock, if statistics are enabled.
+     *
+     * @param path Path to the file (e.g., "~/src/app.cpp"). It must outlive this object.
+     */
+    explicit ScopedFile(const std::filesystem::path &path);
+
+    /**
+     * @brief Destroy the ScopedFile object and count the file.
+     */
+    ~ScopedFile();
+
+    ScopedFile(const ScopedFile &) = delete;
+    ScopedFile &operator=(const ScopedFile &) = delete;
+
+  private:
+    /**
+     * @brief Path to the file.
+     */
+    const std::filesystem::path &path_;
+
+    /**
+     * @brief If true, statistics were enabled on construction, so the destructor has to count the file.
+     */
+    const bool active_;
+
+    /**
+     * @brief Time at which the object was constructed.
+     */
+    const std::chrono::steady_clock::time_point start_;
+
+    /**
+     * @brief Number of allocations of the calling thread at construction, if allocations are tracked.
+     */
+    std::size_t start_allocations_;
+
+    /**
+     * @brief Number of bytes allocated by the calling thread at construction, if allocations are tracked.
+     */
+    std::size_t start_bytes_;
+};
+
+/**
+ * @brief Class that represents a histogram of latencies with logarithmic buckets, in the style of HdrHistogram.
+ *
+ * Latencies below 32 ns are counted exactly. Above, each power of two is split into 32 linear sub-buckets, so every recorded latency is within about 3% of the value reported for it, at a fixed size independent of the range.
+ *
+ * @note This class is marked as `final` to prevent inheritance. It is not synchronized, each thread records into its own histogram, and the histograms are merged at the end.
+ */
+class Histogram final {
+  public:
+    /**
+     * @brief Record a latency.
+     *
+     * @param value Latency to record, negative values are recorded as zero.
+     */
+    void record(const std::chrono::nanoseconds value);
+
+    /**
+     * @brief Add the counts of another histogram to this one.
+     *
+     * @param other Histogram to merge.
+     */
+    void merge(const Histogram &other);
+
+    /**
+     * @brief Get the number of recorded latencies.
+     *
+     * @return Number of recorded latencies (e.g., "500").
+     */
+    [[nodiscard]] std::size_t get_count() const;
+
+    /**
+     * @brief Get the latency below or at which the given percentage of the recorded latencies fall.
+     *
+     * @param percentile Percentage between 0 and 100 (e.g., "99.9").
+     *
+     * @return Highest latency of the bucket that contains the percentile, but at most the largest recorded latency. Zero if nothing was recorded.
+     */
+    [[nodiscard]] std::chrono::nanoseconds get_percentile(const double percentile) const;
+
+    /**
+     * @brief Get the largest recorded latency, exactly.
+     *
+     * @return Largest recorded latency, or zero if nothing was recorded.
+     */
+    [[nodiscard]] std::chrono::nanoseconds get_max() const;
+
+  private:
+    /**
+     * @brief Number of bits used for the sub-buckets of each power of two.
+     */
+    static constexpr unsigned sub_bucket_bits = 5;
+
+    /**
+     * @brief Number of sub-buckets per power of two.
+     */
+    static constexpr std::size_t sub_bucket_count = std::size_t{1} << sub_bucket_bits;
+
+    /**
+     * @brief Number of buckets, enough for any 64-bit latency: exact buckets below "sub_bucket_count", then one row of sub-buckets per remaining power of two.
+     */
+    static constexpr std::size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    /**
+     * @brief Private helper function to get the bucket of a latency.
+     *
+     * @param value Latency in nanoseconds (e.g., "1500").
+     *
+     * @return Index of the bucket.
+     */
+    [[nodiscard]] static std::size_t get_index(const std::uint64_t value);
+
+    /**
+     * @brief Private helper function to get the highest latency counted in a bucket.
+     *
+     * @param index Index of the bucket.
+     *
+     * @return Highest latency in nanoseconds.
+     */
+    [[nodiscard]] static std::uint64_t get_upper_bound(const std::size_t index);
+
+    /**
+     * @brief Number of latencies in each bucket.
+     */
+    std::array<std::size_t, bucket_count> buckets_{};
+
+    /**
+     * @brief Number of recorded latencies.
+     */
+    std::size_t count_ = 0;
+
+    /**
+     * @brief Largest recorded latency in nanoseconds.
+     */
+    std::uint64_t max_ = 0;
+};
+
+/**
+ * @brief Struct that represents the time spent on a single file.
+ */
+struct FileTime final {
+    /**
+     * @brief Path to the file (e.g., "~/src/app.cpp").
+     */
+    std::string path;
+
+    /**
+     * @brief Time spent on the file.
+     */
+    std::chrono::nanoseconds elapsed;
+};
+
+/**
+ * @brief Struct that represents the allocations made while processing a single file.
+ */
+struct FileAllocations final {
+    /**
+     * @brief Path to the file (e.g., "~/src/app.cpp").
+     */
+    std::string path;
+
+    /**
+     * @brief Number of allocations (e.g., "1200").
+     */
+    std::size_t allocations;
+
+    /**
+     * @brief Number of allocated bytes (e.g., "65536").
+     */
+    std::size_t bytes;
+};
+
+/**
+ * @brief Struct that represents the statistics of all threads, merged.
+ */
+struct Summary final {
+    /**
+     * @brief Time spent in each phase, summed over all threads, indexed by Phase.
+     */
+    std::array<std::chrono::nanoseconds, phase_count> phases;
+
+    /**
+     * @brief Number of times each phase was entered, summed over all threads, indexed by Phase (e.g., the number of parsed files for "Phase::Parse").
+     */
+    std::array<std::size_t, phase_count> entries;
+
+    /**
+     * @brief Number of processed files.
+     */
+    std::size_t files;
+
+    /**
+     * @brief Number of bytes read from disk.
+     */
+    std::size_t bytes;
+
+    /**
+     * @brief Busy time of each thread that processed at least one file, in order of the threads' first recording.
+     */
+    std::vector<std::chrono::nanoseconds> busy;
+
+    /**
+     * @brief Latencies of all processed files. The file with the largest latency is the first of "slowest".
+     */
+    Histogram latency;
+
+    /**
+     * @brief Slowest files, sorted by time in descending order. At most "slowest_file_count" entries.
+     */
+    std::vector<FileTime> slowest;
+
+    /**
+     * @brief Number of allocations in each phase, summed over all threads, indexed by Phase. The last element counts allocations outside of any phase. All zero if allocations are not tracked.
+     */
+    std::array<std::size_t, phase_count + 1> allocations;
+
+    /**
+     * @brief Number of bytes allocated in each phase, indexed like "allocations".
+     */
+    std::array<std::size_t, phase_count + 1> allocated_bytes;
+
+    /**
+     * @brief Files with the most allocated bytes, sorted in descending order. At most "slowest_file_count" entries, empty if allocations are not tracked.
+     */
+    std::vector<FileAllocations> top_allocating;
+
+    /**
+     * @brief Hardware events counted in each phase, summed over all threads, indexed by Phase. All zero if the counters are not available.
+     */
+    std::array<core::perf::Sample, phase_count> events;
+
+    /**
+     * @brief If true, the event was counted on every thread, indexed by core::perf::Event. All false if the counters are not available.
+     */
+    std::array<bool, core::perf::event_count> counted;
+
+    /**
+     * @brief Reason why the hardware counters are not available on at least one thread (e.g., "perf_event_open: Permission denied"), or empty if they are available.
+     */
+    std::string counters_error;
+};
+
+/**
+ * @brief Merge the statistics of all threads.
+ *
+ * @return Summary of all threads.
+ *
+ * @note This must not be called while other threads are recording.
+ */
+[[nodiscard]] Summary collect();
+
+/**
+ * @brief Get the peak resident set size of the process, i.e., the most physical memory it has used so far.
+ *
+ * @return Peak resident set size in bytes (e.g., "52428800"), or std::nullopt if it is not available on this platform.
+ */
+[[nodiscard]] std::optional<std::size_t> get_peak_rss();
+
+}  // namespace core::stats
@@ -0,0 +1,278 @@
+/**
+ * @file stdlib.cpp
+ */
+
+#include <algorithm>    // for std::stable_sort, std::lower_bound, std::upper_bound, std::find_if
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t
+#include <optional>     // for std::optional, std::nullopt
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <utility>      // for std::pair
+#include <vector>       // for std::vector
+
+#include "stdlib.hpp"
+
+namespace core::stdlib {
+
+namespace {
+
+/**
+ * @brief Struct that represents the functions provided by a single header.
+ */
+struct HeaderFunctions final {
+    /**
+     * @brief Header name without angle brackets (e.g., "utility").
+     */
+    std::string_view header;
+
+    /**
+     * @brief Space-separated functions without the "std::" prefix, in lowercase (e.g., "pair make_pair swap").
+     */
+    std::string_view functions;
+};
+
+/**
+ * @brief Table of standard headers and the functions they provide.
+ *
+ * If a function is provided by several headers, the first header that lists it is the preferred one, so more specific headers come before the headers that merely re-export a function (e.g., <utility> before <algorithm> for std::swap).
+ */
+constexpr std::array<HeaderFunctions, 82> table = {{
+    {"cstddef", "size_t ptrdiff_t nullptr_t byte max_align_t"},
+    {"cstdint", "int8_t int16_t int32_t int64_t uint8_t uint16_t uint32_t uint64_t int_fast8_t int_fast16_t int_fast32_t int_fast64_t "
+                "uint_fast8_t uint_fast16_t uint_fast32_t uint_fast64_t int_least8_t int_least16_t int_least32_t int_least64_t "
+                "uint_least8_t uint_least16_t uint_least32_t uint_least64_t intptr_t uintptr_t intmax_t uintmax_t"},
+    {"utility", "pair make_pair move forward swap exchange declval as_const index_sequence make_index_sequence integer_sequence "
+                "make_integer_sequence in_place in_place_t piecewise_construct to_underlying unreachable get tuple_size tuple_element"},
+    {"tuple", "tuple make_tuple tie forward_as_tuple tuple_cat apply make_from_tuple ignore"},
+    {"iterator", "begin end cbegin cend rbegin rend crbegin crend size ssize empty data next prev advance distance iterator_traits "
+                 "reverse_iterator move_iterator make_move_iterator make_reverse_iterator back_inserter front_inserter inserter "
+                 "back_insert_iterator front_insert_iterator insert_iterator istream_iterator ostream_iterator istreambuf_iterator "
+                 "ostreambuf_iterator input_iterator_tag output_iterator_tag forward_iterator_tag bidirectional_iterator_tag "
+                 "random_access_iterator_tag"},
+    {"initializer_list", "initializer_list"},
+    {"algorithm", "all_of any_of none_of for_each for_each_n count count_if mismatch find find_if find_if_not find_end find_first_of "
+                  "adjacent_find search search_n copy copy_if copy_n copy_backward move_backward fill fill_n transform generate "
+                  "generate_n remove_if remove_copy remove_copy_if replace replace_if replace_copy replace_copy_if swap_ranges reverse "
+                  "reverse_copy rotate rotate_copy shuffle sample unique unique_copy is_partitioned partition partition_copy "
+                  "stable_partition partition_point is_sorted is_sorted_until sort partial_sort partial_sort_copy stable_sort "
+                  "nth_element lower_bound upper_bound binary_search equal_range merge inplace_merge includes set_difference "
+                  "set_intersection set_symmetric_difference set_union is_heap is_heap_until make_heap push_heap pop_heap sort_heap "
+                  "max max_element min min_element minmax minmax_element clamp equal lexicographical_compare is_permutation "
+                  "next_permutation prev_permutation iter_swap move swap"},
+    {"numeric", "iota accumulate inner_product adjacent_difference partial_sum reduce exclusive_scan inclusive_scan transform_reduce "
+                "transform_exclusive_scan transform_inclusive_scan gcd lcm midpoint"},
+    {"memory", "unique_ptr shared_ptr weak_ptr make_unique make_shared allocate_shared enable_shared_from_this allocator allocator_traits "
+               "addressof static_pointer_cast dynamic_pointer_cast const_pointer_cast reinterpret_pointer_cast default_delete owner_less "
+               "pointer_traits uninitialized_copy uninitialized_copy_n uninitialized_fill uninitialized_fill_n uninitialized_move "
+               "destroy destroy_at construct_at align bad_weak_ptr"},
+    {"memory_resource", "pmr pmr::memory_resource pmr::polymorphic_allocator pmr::monotonic_buffer_resource pmr::synchronized_pool_resource "
+                        "pmr::unsynchronized_pool_resource pmr::pool_options pmr::new_delete_resource pmr::null_memory_resource "
+                        "pmr::get_default_resource pmr::set_default_resource"},
+    {"functional", "function bind ref cref reference_wrapper hash less greater equal_to not_equal_to less_equal greater_equal plus minus "
+                   "multiplies divides modulus negate logical_and logical_or logical_not bit_and bit_or bit_xor bit_not invoke mem_fn "
+                   "not_fn placeholders bad_function_call identity"},
+    {"type_traits", "integral_constant bool_constant true_type false_type is_void is_null_pointer is_integral is_floating_point is_array "
+                    "is_enum is_union is_class is_function is_pointer is_lvalue_reference is_rvalue_reference is_reference is_arithmetic "
+                    "is_fundamental is_object is_scalar is_compound is_member_pointer is_const is_volatile is_trivial is_trivially_copyable "
+                    "is_standard_layout is_empty is_polymorphic is_abstract is_final is_aggregate is_signed is_unsigned is_constructible "
+                    "is_default_constructible is_copy_constructible is_move_constructible is_assignable is_copy_assignable "
+                    "is_move_assignable is_destructible is_trivially_constructible is_trivially_destructible is_nothrow_constructible "
+                    "is_nothrow_move_constructible is_nothrow_move_assignable is_nothrow_swappable is_swappable is_same is_base_of "
+                    "is_convertible is_invocable is_invocable_r is_nothrow_invocable is_void_v is_integral_v is_floating_point_v "
+                    "is_arithmetic_v is_pointer_v is_enum_v is_class_v is_const_v is_signed_v is_unsigned_v is_same_v is_base_of_v "
+                    "is_convertible_v is_invocable_v is_trivially_copyable_v is_constructible_v is_default_constructible_v "
+                    "is_nothrow_move_constructible_v is_lvalue_reference_v is_reference_v alignment_of rank extent remove_cv remove_const "
+                    "remove_volatile add_cv add_const add_volatile remove_reference add_lvalue_reference add_rvalue_reference "
+                    "make_signed make_unsigned remove_extent remove_all_extents remove_pointer add_pointer aligned_storage decay "
+                    "remove_cvref enable_if conditional common_type underlying_type invoke_result void_t conjunction disjunction "
+                    "negation remove_cv_t remove_const_t remove_reference_t add_const_t add_pointer_t make_signed_t make_unsigned_t "
+                    "decay_t remove_cvref_t enable_if_t conditional_t common_type_t underlying_type_t invoke_result_t "
+                    "is_constant_evaluated"},
+    {"limits", "numeric_limits float_round_style float_denorm_style"},
+    {"ratio", "ratio ratio_add ratio_subtract ratio_multiply ratio_divide ratio_equal ratio_less atto femto pico nano micro milli centi "
+              "deci deca hecto kilo mega giga tera peta exa"},
+    {"chrono", "chrono"},
+    {"exception", "exception exception_ptr current_exception rethrow_exception make_exception_ptr terminate nested_exception "
+                  "throw_with_nested rethrow_if_nested uncaught_exceptions bad_exception set_terminate terminate_handler"},
+    {"stdexcept", "runtime_error logic_error invalid_argument out_of_range length_error domain_error overflow_error underflow_error "
+                  "range_error exception"},
+    {"new", "bad_alloc bad_array_new_length nothrow nothrow_t align_val_t launder set_new_handler new_handler "
+            "hardware_destructive_interference_size hardware_constructive_interference_size"},
+    {"typeinfo", "type_info bad_cast bad_typeid"},
+    {"typeindex", "type_index"},
+    {"system_error", "error_code error_condition system_error errc error_category generic_category system_category make_error_code "
+                     "make_error_condition is_error_code_enum is_error_condition_enum"},
+    {"string_view", "string_view wstring_view u8string_view u16string_view u32string_view basic_string_view"},
+    {"string", "string wstring u8string u16string u32string basic_string char_traits to_string to_wstring stoi stol stoll stoul stoull "
+               "stof stod stold getline pmr::string pmr::wstring pmr::u16string pmr::u32string pmr::u8string pmr::basic_string"},
+    {"charconv", "to_chars from_chars chars_format to_chars_result from_chars_result"},
+    {"format", "format format_to format_to_n formatted_size vformat vformat_to make_format_args formatter format_error"},
+    {"print", "print println"},
+    {"optional", "optional nullopt nullopt_t make_optional bad_optional_access"},
+    {"variant", "variant visit get_if holds_alternative monostate variant_size variant_alternative variant_npos bad_variant_access"},
+    {"any", "any any_cast make_any bad_any_cast"},
+    {"expected", "expected unexpected bad_expected_access unexpect"},
+    {"bit", "bit_cast byteswap popcount countl_zero countl_one countr_zero countr_one has_single_bit bit_ceil bit_floor bit_width "
+            "rotl rotr endian"},
+    {"compare", "strong_ordering weak_ordering partial_ordering three_way_comparable compare_three_way"},
+    {"source_location", "source_location"},
+    {"array", "array to_array"},
+    {"vector", "vector pmr::vector"},
+    {"deque", "deque pmr::deque"},
+    {"list", "list pmr::list"},
+    {"forward_list", "forward_list pmr::forward_list"},
+    {"map", "map multimap pmr::map pmr::multimap"},
+    {"set", "set multiset pmr::set pmr::multiset"},
+    {"unordered_map", "unordered_map unordered_multimap pmr::unordered_map pmr::unordered_multimap"},
+    {"unordered_set", "unordered_set unordered_multiset pmr::unordered_set pmr::unordered_multiset"},
+    {"stack", "stack"},
+    {"queue", "queue priority_queue"},
+    {"bitset", "bitset"},
+    {"span", "span dynamic_extent"},
+    {"valarray", "valarray slice gslice"},
+    {"complex", "complex"},
+    {"random", "mt19937 mt19937_64 minstd_rand minstd_rand0 ranlux24 ranlux48 knuth_b default_random_engine random_device seed_seq "
+               "uniform_int_distribution uniform_real_distribution bernoulli_distribution binomial_distribution geometric_distribution "
+               "poisson_distribution exponential_distribution normal_distribution lognormal_distribution discrete_distribution "
+               "generate_canonical mersenne_twister_engine linear_congruential_engine"},
+    {"ranges", "ranges views"},
+    {"execution", "execution"},
+    {"numbers", "numbers"},
+    {"concepts", "same_as derived_from convertible_to integral signed_integral unsigned_integral floating_point invocable predicate "
+                 "regular semiregular copyable movable"},
+    {"filesystem", "filesystem"},
+    {"regex", "regex wregex basic_regex smatch cmatch wsmatch wcmatch ssub_match csub_match match_results sub_match regex_search "
+              "regex_match regex_replace regex_error regex_constants regex_iterator sregex_iterator cregex_iterator regex_token_iterator "
+              "sregex_token_iterator cregex_token_iterator regex_traits pmr::match_results pmr::smatch pmr::cmatch pmr::wsmatch "
+              "pmr::wcmatch"},
+    {"atomic", "atomic atomic_ref atomic_flag memory_order memory_order_relaxed memory_order_consume memory_order_acquire "
+               "memory_order_release memory_order_acq_rel memory_order_seq_cst atomic_thread_fence atomic_signal_fence kill_dependency"},
+    {"thread", "thread this_thread jthread"},
+    {"stop_token", "stop_token stop_source stop_callback"},
+    {"mutex", "mutex recursive_mutex timed_mutex recursive_timed_mutex lock_guard unique_lock scoped_lock once_flag call_once try_lock "
+              "lock defer_lock adopt_lock try_to_lock defer_lock_t adopt_lock_t try_to_lock_t"},
+    {"shared_mutex", "shared_mutex shared_timed_mutex shared_lock"},
+    {"condition_variable", "condition_variable condition_variable_any cv_status notify_all_at_thread_exit"},
+    {"future", "future shared_future promise packaged_task async launch future_status future_error future_errc"},
+    {"semaphore", "counting_semaphore binary_semaphore"},
+    {"latch", "latch"},
+    {"barrier", "barrier"},
+    {"ios", "ios ios_base basic_ios streamsize streamoff fpos boolalpha noboolalpha showbase noshowbase showpoint noshowpoint showpos "
+            "noshowpos skipws noskipws uppercase nouppercase unitbuf nounitbuf internal left right dec hex oct fixed scientific "
+            "hexfloat defaultfloat io_errc iostream_category"},
+    {"streambuf", "streambuf wstreambuf basic_streambuf"},
+    {"istream", "istream wistream basic_istream iostream wiostream basic_iostream ws"},
+    {"ostream", "ostream wostream basic_ostream endl ends flush"},
+    {"iostream", "cout cin cerr clog wcout wcin wcerr wclog ios ios_base streamsize boolalpha noboolalpha showpos fixed scientific hex "
+                 "dec oct left right istream ostream iostream endl ends flush ws"},
+    {"iomanip", "setw setprecision setfill setbase setiosflags resetiosflags put_time get_time put_money get_money quoted"},
+    {"sstream", "stringstream istringstream ostringstream stringbuf wstringstream wistringstream wostringstream basic_stringstream "
+                "basic_istringstream basic_ostringstream"},
+    {"fstream", "fstream ifstream ofstream filebuf wfstream wifstream wofstream basic_fstream basic_ifstream basic_ofstream"},
+    {"cstdio", "printf fprintf sprintf snprintf vprintf vfprintf vsnprintf scanf fscanf sscanf puts fputs fgets fputc fgetc putchar "
+               "getchar fopen freopen fclose fread fwrite fflush fseek ftell rewind feof ferror perror rename tmpfile file fpos_t "
+               "size_t"},
+    {"cstdlib", "exit abort atexit quick_exit at_quick_exit getenv system malloc calloc realloc free aligned_alloc atoi atol atoll atof "
+                "strtol strtoll strtoul strtoull strtof strtod strtold rand srand abs labs llabs div ldiv qsort bsearch size_t"},
+    {"cstring", "strlen strcmp strncmp strcpy strncpy strcat strncat strchr strrchr strstr strtok strspn strcspn strpbrk strerror memcpy "
+                "memmove memset memcmp memchr size_t"},
+    {"cctype", "isalpha isdigit isalnum isspace isupper islower isprint ispunct isxdigit iscntrl isgraph isblank toupper tolower"},
+    {"cmath", "abs fabs fmod remainder fma fmax fmin fdim exp exp2 expm1 log log10 log2 log1p pow sqrt cbrt hypot sin cos tan asin acos "
+              "atan atan2 sinh cosh tanh asinh acosh atanh erf erfc tgamma lgamma ceil floor trunc round lround llround nearbyint rint "
+              "frexp ldexp modf scalbn ilogb logb nextafter copysign nan isfinite isinf isnan isnormal signbit lerp"},
+    {"ctime", "time time_t clock clock_t tm difftime mktime localtime gmtime asctime ctime strftime timespec size_t"},
+    {"csignal", "signal raise sig_atomic_t"},
+    {"cstdarg", "va_list"},
+    {"locale", "locale use_facet has_facet isalpha isdigit isalnum isspace isupper islower toupper tolower"},
+}};
+
+/**
+ * @brief Private helper function to build the sorted function-to-header index from the table once.
+ *
+ * @return Const reference to a vector of (function, header) pairs, sorted by function. Headers of the same function keep their table order, so the preferred header comes first.
+ */
+[[nodiscard]] const std::vector<std::pair<std::string, std::string_view>> &get_index()
+{
+    // Initialization of function-local statics is thread-safe, so the index is built exactly once
+    static const std::vector<std::pair<std::string, std::string_view>> index = [] {
+        std::vector<std::pair<std::string, std::string_view>> entries;
+        for (const auto &[header, functions] : table) {
+            std::size_t start = 0;
+            while (start < functions.size()) {
+                std::size_t stop = functions.find(' ', start);
+                if (stop == std::string_view::npos) {
+                    stop = functions.size();
+                }
+                if (stop > start) {
+                    entries.emplace_back("std::" + std::string(functions.substr(start, stop - start)), header);
+                }
+                start = stop + 1;
+            }
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        return entries;
+    }();
+    return index;
+}
+
+/**
+ * @brief Private helper function to find the index entries of a function.
+ *
+ * @param function Function prefixed with "std::" in lowercase (e.g., "std::swap").
+ *
+ * @return Pair of iterators that delimit the entries of the function, empty if unknown.
+ */
+[[nodiscard]] auto find_entries(const std::string_view function)
+{
+    // Compare against the view directly, so that a lookup does not copy the function into a temporary entry
+    const auto &index = get_index();
+    const auto first = std::lower_bound(index.cbegin(), index.cend(), function,
+                                        [](const auto &entry, const std::string_view name) { return entry.first < name; });
+    const auto last = std::upper_bound(first, index.cend(), function,
+                                       [](const std::string_view name, const auto &entry) { return name < entry.first; });
+    return std::pair(first, last);
+}
+
+}  // namespace
+
+std::vector<std::string_view> find_headers(const std::string_view function)
+{
+    const auto [first, last] = find_entries(function);
+    std::vector<std::string_view> headers;
+    for (auto it = first; it != last; ++it) {
+        headers.emplace_back(it->second);
+    }
+    return headers;
+}
+
+std::optional<std::string_view> find_primary_header(const std::string_view function)
+{
+    const auto [first, last] = find_entries(function);
+    if (first == last) {
+        return std::nullopt;
+    }
+    return first->second;
+}
+
+bool is_known_header(const std::string_view header)
+{
+    return std::find_if(table.cbegin(), table.cend(), [header](const HeaderFunctions &entry) { return entry.header == header; }) !=
+           table.cend();
+}
+
+const std::vector<std::string> &get_known_functions()
+{
+    static const std::vector<std::string> functions = [] {
+        std::vector<std::string> result;
+        for (const auto &[function, header] : get_index()) {
+            if (result.empty() || result.back() != function) {
+                result.push_back(function);
+            }
+        }
+        return result;
+    }();
+    return functions;
+}
+
+}  // namespace core::stdlib
@@ -0,0 +1,52 @@
+/**
+ * @file stdlib.hpp
+ *
+ * @brief Look up which standard library headers provide which functions.
+ */
+
+#pragma once
+
+#include <optional>     // for std::optional
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+namespace core::stdlib {
+
+/**
+ * @brief Find all headers that provide a standard function.
+ *
+ * The table is compiled into the binary and covers the commonly used parts of the standard library, it is not exhaustive.
+ *
+ * @param function Function prefixed with "std::" in lowercase (e.g., "std::swap").
+ *
+ * @return Vector of header names without angle brackets, the preferred header first (e.g., {"utility", "algorithm", "string", ...}). Empty if the function is unknown.
+ */
+[[nodiscard]] std::vector<std::string_view> find_headers(std::string_view function);
+
+/**
+ * @brief Find the preferred header of a standard function.
+ *
+ * @param function Function prefixed with "std::" in lowercase (e.g., "std::sort").
+ *
+ * @return Header name without angle brackets (e.g., "algorithm"), or std::nullopt if the function is unknown.
+ */
+[[nodiscard]] std::optional<std::string_view> find_primary_header(std::string_view function);
+
+/**
+ * @brief Check if a header is a standard header that appears in the table.
+ *
+ * @param header Header name without angle brackets in lowercase (e.g., "vector").
+ *
+ * @return True if the header is known, false otherwise (e.g., "fmt/core.h").
+ */
+[[nodiscard]] bool is_known_header(std::string_view header);
+
+/**
+ * @brief Get all functions in the table.
+ *
+ * @return Const reference to a sorted vector of unique functions prefixed with "std::" (e.g., {"std::abort", "std::abs", ...}).
+ */
+[[nodiscard]] const std::vector<std::string> &get_known_functions();
+
+}  // namespace core::stdlib
@@ -2,12 +2,14 @@
  * @file string.cpp
  */
 
-#include <algorithm>      // for std::transform, std::find_if_not
+#include <algorithm>      // for std::transform, std::find_if_not, std::min
+#include <array>          // for std::array
 #include <cctype>         // for std::tolower, std::isspace
 #include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint64_t
 #include <filesystem>     // for std::filesystem
-#include <sstream>        // for std::ostringstream
 #include <string>         // for std::string
+#include <string_view>    // for std::string_view
 #include <unordered_map>  // for std::unordered_map
 #include <vector>         // for std::vector
 
@@ -91,9 +93,9 @@ std::string create_cpp_reference_link(const std::string &name)
         {']', "%5D"},
     };
 
-    // Initialize the link with the base URL for the DuckDuckGo search
-    std::ostringstream link;
-    link << "https://duckduckgo.com/?sites=cppreference.com&q=";
+    // Initialize the link with the base URL for the DuckDuckGo search, reserving room for every character to be encoded
+    std::string link = "https://duckduckgo.com/?sites=cppreference.com&q=";
+    link.reserve(link.size() + name.size() * 3 + 7);
 
     // Iterate over each character in the provided function name (e.g., "std::string") to encode it
     for (const char character : name) {
@@ -101,19 +103,77 @@ std::string create_cpp_reference_link(const std::string &name)
         // Find the character in the URL encoding map (e.g., ":")
         if (const auto &encoded = url_encoding.find(character); encoded != url_encoding.cend()) {
             // If found, add the URL-encoded version of the character (e.g., "%3A")
-            link << encoded->second;
+            link += encoded->second;
         }
         else {
             // Otherwise, add the original character (e.g., ":")
-            link << character;
+            link += character;
         }
     }
 
     // Add the final part of the URL
-    link << "&ia=web";
+    link += "&ia=web";
 
-    // Return the link as a string
-    return link.str();
+    // Return the link
+    return link;
+}
+
+std::size_t edit_distance(const std::string_view a,
+                          const std::string_view b)
+{
+    const std::size_t m = a.size();
+    if (m == 0) {
+        return b.size();
+    }
+
+    // Fall back to dynamic programming with a single row if the first string does not fit into a machine word
+    if (m > 64) {
+        std::vector<std::size_t> row(m + 1);
+        for (std::size_t i = 0; i <= m; ++i) {
+            row[i] = i;
+        }
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            std::size_t diagonal = row[0];
+            row[0] = j;
+            for (std::size_t i = 1; i <= m; ++i) {
+                const std::size_t above = row[i];
+                row[i] = std::min({row[i] + 1, row[i - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+                diagonal = above;
+            }
+        }
+        return row[m];
+    }
+
+    // Bit mask of the positions of each character in the first string
+    std::array<std::uint64_t, 256> peq{};
+    for (std::size_t i = 0; i < m; ++i) {
+        peq[static_cast<unsigned char>(a[i])] |= std::uint64_t{1} << i;
+    }
+
+    // Track the vertical deltas of the last column as positive and negative bit vectors, and the score of the last row
+    const std::uint64_t last = std::uint64_t{1} << (m - 1);
+    std::uint64_t pv = ~std::uint64_t{0};
+    std::uint64_t mv = 0;
+    std::size_t score = m;
+    for (const char c : b) {
+        const std::uint64_t eq = peq[static_cast<unsigned char>(c)];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+        if (ph & last) {
+            ++score;
+        }
+        else if (mh & last) {
+            --score;
+        }
+        // The first row grows by one per character, so a positive delta is shifted in
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
 }
 
 }  // namespace core::string
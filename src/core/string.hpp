@@ -6,9 +6,11 @@
 
 #pragma once
 
-#include <filesystem>  // for std::filesystem
-#include <string>      // for std::string
-#include <vector>      // for std::vector
+#include <cstddef>      // for std::size_t
+#include <filesystem>   // for std::filesystem
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
 
 namespace core::string {
 
@@ -58,4 +60,17 @@ namespace core::string {
  */
 [[nodiscard]] std::string create_cpp_reference_link(const std::string &name);
 
+/**
+ * @brief Compute the Levenshtein distance between two strings, i.e., the minimum number of single-character insertions, deletions and substitutions that turn one into the other.
+ *
+ * If the first string is at most 64 characters long, the bit-parallel algorithm by Myers (1999), as formulated by Hyyrö (2001), is used, which processes each character of the second string in a few word operations. Longer strings fall back to the dynamic programming algorithm.
+ *
+ * @param a First string (e.g., "std::trasform").
+ * @param b Second string (e.g., "std::transform").
+ *
+ * @return Edit distance (e.g., "1").
+ */
+[[nodiscard]] std::size_t edit_distance(std::string_view a,
+                                        std::string_view b);
+
 }  // namespace core::string
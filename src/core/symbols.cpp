@@ -0,0 +1,91 @@
+/**
+ * @file symbols.cpp
+ */
+
+#include <algorithm>      // for std::lower_bound
+#include <deque>          // for std::deque
+#include <mutex>          // for std::unique_lock
+#include <shared_mutex>   // for std::shared_mutex, std::shared_lock
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <unordered_map>  // for std::unordered_map
+
+#include "stdlib.hpp"
+#include "symbols.hpp"
+
+namespace core::symbols {
+
+namespace {
+
+/**
+ * @brief Struct that represents the names that are not in the compiled table, interned at runtime.
+ *
+ * @note This struct is marked as `final` to prevent inheritance. A deque is used, so that the views in the map stay valid when names are added.
+ */
+struct DynamicTable final {
+    /**
+     * @brief Mutex that protects the members below, lookups take it shared.
+     */
+    std::shared_mutex mutex;
+
+    /**
+     * @brief Names, indexed by ID minus the number of known functions.
+     */
+    std::deque<std::string> names;
+
+    /**
+     * @brief Map of names to their IDs, the views refer to "names".
+     */
+    std::unordered_map<std::string_view, Id> ids;
+};
+
+/**
+ * @brief Private helper function to get the table of names interned at runtime.
+ *
+ * @return Reference to the table, created on the first call.
+ */
+[[nodiscard]] DynamicTable &get_dynamic_table()
+{
+    static DynamicTable table;
+    return table;
+}
+
+}  // namespace
+
+Id intern(const std::string_view name)
+{
+    // The known functions are sorted, so their index serves as a fixed ID
+    const auto &known = core::stdlib::get_known_functions();
+    if (const auto it = std::lower_bound(known.cbegin(), known.cend(), name); it != known.cend() && *it == name) {
+        return static_cast<Id>(it - known.cbegin());
+    }
+
+    // Look the name up under a shared lock first, since most runtime names are interned by the first file that uses them
+    DynamicTable &table = get_dynamic_table();
+    {
+        const std::shared_lock<std::shared_mutex> lock(table.mutex);
+        if (const auto it = table.ids.find(name); it != table.ids.cend()) {
+            return it->second;
+        }
+    }
+    const std::unique_lock<std::shared_mutex> lock(table.mutex);
+    if (const auto it = table.ids.find(name); it != table.ids.cend()) {
+        return it->second;
+    }
+    const auto id = static_cast<Id>(known.size() + table.names.size());
+    table.ids.emplace(table.names.emplace_back(name), id);
+    return id;
+}
+
+std::string_view get_name(const Id id)
+{
+    const auto &known = core::stdlib::get_known_functions();
+    if (id < known.size()) {
+        return known[id];
+    }
+    DynamicTable &table = get_dynamic_table();
+    const std::shared_lock<std::shared_mutex> lock(table.mutex);
+    return table.names.at(id - known.size());
+}
+
+}  // namespace core::symbols
@@ -0,0 +1,39 @@
+/**
+ * @file symbols.hpp
+ *
+ * @brief Intern standard function names as compact IDs.
+ */
+
+#pragma once
+
+#include <cstdint>      // for std::uint32_t
+#include <string_view>  // for std::string_view
+
+namespace core::symbols {
+
+/**
+ * @brief ID of an interned function name, equal for equal names and stable for the lifetime of the process.
+ */
+using Id = std::uint32_t;
+
+/**
+ * @brief Get the ID of a function name, interning it on first use.
+ *
+ * The functions in the compiled table have fixed IDs and are looked up without locking. Other names (e.g., typos or functions missing from the table) are added to a table that is shared by all threads.
+ *
+ * @param name Function prefixed with "std::" in lowercase (e.g., "std::sort").
+ *
+ * @return ID of the function.
+ */
+[[nodiscard]] Id intern(std::string_view name);
+
+/**
+ * @brief Get the name of an interned function.
+ *
+ * @param id ID returned by "intern".
+ *
+ * @return Function prefixed with "std::" in lowercase (e.g., "std::sort"), valid for the lifetime of the process.
+ */
+[[nodiscard]] std::string_view get_name(Id id);
+
+}  // namespace core::symbols
@@ -0,0 +1,206 @@
+/**
+ * @file trace.cpp
+ */
+
+#include <atomic>      // for std::atomic, std::memory_order_relaxed
+#include <chrono>      // for std::chrono
+#include <cstddef>     // for std::size_t
+#include <filesystem>  // for std::filesystem
+#include <iterator>    // for std::back_inserter
+#include <list>        // for std::list
+#include <mutex>       // for std::mutex, std::lock_guard
+#include <ratio>       // for std::micro
+#include <string>      // for std::string
+#include <vector>      // for std::vector
+
+#include <fmt/core.h>
+
+#include "io.hpp"
+#include "trace.hpp"
+
+namespace core::trace {
+
+namespace {
+
+/**
+ * @brief Private helper struct that represents a finished span.
+ */
+struct Span final {
+    /**
+     * @brief Name of the span (e.g., "parse").
+     */
+    const char *name;
+
+    /**
+     * @brief Path to the file the span is about, or empty if none (e.g., "~/src/app.cpp").
+     */
+    std::string path;
+
+    /**
+     * @brief Time at which the span started.
+     */
+    std::chrono::steady_clock::time_point start;
+
+    /**
+     * @brief Time at which the span ended.
+     */
+    std::chrono::steady_clock::time_point end;
+};
+
+/**
+ * @brief If true, spans are recorded.
+ */
+std::atomic<bool> recording{false};
+
+/**
+ * @brief Mutex that protects the registry. It is only locked once per thread, when the thread records for the first time.
+ */
+std::mutex registry_mutex;
+
+/**
+ * @brief Span buffers of all threads that have recorded so far. A list is used, so that the elements never move.
+ */
+std::list<std::vector<Span>> registry;
+
+/**
+ * @brief Time of the last reset, the timestamps of the trace are relative to it.
+ */
+std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+/**
+ * @brief Private helper function to get the span buffer of the calling thread, registering it on first use.
+ *
+ * @return Reference to the span buffer of the calling thread.
+ */
+std::vector<Span> &get_local()
+{
+    thread_local std::vector<Span> *local = nullptr;
+    if (local == nullptr) {
+        const std::lock_guard<std::mutex> lock(registry_mutex);
+        local = &registry.emplace_back();
+    }
+    return *local;
+}
+
+/**
+ * @brief Private helper function to escape a string for use inside a JSON string literal.
+ *
+ * @param str String to escape (e.g., "C:\\src\\app.cpp").
+ *
+ * @return Escaped string, without surrounding quotes (e.g., "C:\\\\src\\\\app.cpp").
+ */
+std::string escape_json(const std::string &str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (const char c : str) {
+        switch (c) {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        default:
+            // Control characters must be escaped, everything else (including UTF-8) is copied as is
+            if (static_cast<unsigned char>(c) < 0x20) {
+                escaped += fmt::format("\\u{:04x}", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+            }
+            else {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Private helper function to convert a time point to microseconds since the last reset.
+ *
+ * @param time Time point to convert.
+ *
+ * @return Microseconds since the last reset (e.g., "1234.567").
+ */
+double to_microseconds(const std::chrono::steady_clock::time_point time)
+{
+    return std::chrono::duration<double, std::micro>(time - epoch).count();
+}
+
+}  // namespace
+
+void set_enabled(const bool enabled)
+{
+    recording.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_enabled()
+{
+    return recording.load(std::memory_order_relaxed);
+}
+
+void reset()
+{
+    const std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto &local : registry) {
+        local.clear();
+    }
+    epoch = std::chrono::steady_clock::now();
+}
+
+ScopedSpan::ScopedSpan(const char *name)
+    : name_(name),
+      path_(nullptr),
+      active_(is_enabled()),
+      start_(this->active_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{})
+{
+}
+
+ScopedSpan::ScopedSpan(const char *name,
+                       const std::filesystem::path &path)
+    : name_(name),
+      path_(&path),
+      active_(is_enabled()),
+      start_(this->active_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{})
+{
+}
+
+ScopedSpan::~ScopedSpan()
+{
+    if (this->active_) {
+        get_local().push_back({this->name_, this->path_ ? this->path_->string() : std::string(), this->start_, std::chrono::steady_clock::now()});
+    }
+}
+
+void write(const std::filesystem::path &output_path)
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    {
+        const std::lock_guard<std::mutex> lock(registry_mutex);
+        std::size_t thread_id = 0;
+        bool first = true;
+        for (const auto &local : registry) {
+            ++thread_id;
+            // Skip threads without spans, e.g., threads that only recorded before the last reset
+            if (local.empty()) {
+                continue;
+            }
+            // Name the track of the thread, the numbers match the order of the threads' first recording
+            fmt::format_to(std::back_inserter(json), "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"thread {}\"}}}}",
+                           first ? "" : ",\n", thread_id, thread_id);
+            first = false;
+            // Complete events ("X") carry their duration, so each span is a single event
+            for (const auto &span : local) {
+                fmt::format_to(std::back_inserter(json), ",\n{{\"name\":\"{}\",\"cat\":\"header-warden\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                               span.name, thread_id, to_microseconds(span.start), to_microseconds(span.end) - to_microseconds(span.start));
+                if (!span.path.empty()) {
+                    fmt::format_to(std::back_inserter(json), ",\"args\":{{\"path\":\"{}\"}}", escape_json(span.path));
+                }
+                json += '}';
+            }
+        }
+    }
+    json += "\n]}\n";
+    core::io::write_text_atomically(output_path, json);
+}
+
+}  // namespace core::trace
@@ -0,0 +1,105 @@
+/**
+ * @file trace.hpp
+ *
+ * @brief Record spans of work per thread and export them in the Chrome trace-event format, e.g., to view them in Perfetto.
+ */
+
+#pragma once
+
+#include <chrono>      // for std::chrono
+#include <filesystem>  // for std::filesystem
+
+namespace core::trace {
+
+/**
+ * @brief Enable or disable the recording of spans for all threads.
+ *
+ * When disabled, recording is reduced to a single relaxed atomic load, so the instrumentation can stay in place.
+ *
+ * @param enabled If true, spans are recorded from now on.
+ */
+void set_enabled(const bool enabled);
+
+/**
+ * @brief Check if spans are being recorded.
+ *
+ * @return True if enabled, false otherwise.
+ */
+[[nodiscard]] bool is_enabled();
+
+/**
+ * @brief Discard the spans of all threads and restart the clock, so that the timestamps of the trace start at zero.
+ *
+ * @note This must not be called while other threads are recording.
+ */
+void reset();
+
+/**
+ * @brief Class that records a span covering its lifetime on the calling thread, if recording is enabled.
+ *
+ * Each thread appends to its own buffer, so the threads never wait for each other while recording. Spans on the same thread nest by time.
+ *
+ * @note This class is marked as `final` to prevent inheritance. It must be destroyed on the thread that created it.
+ */
+class ScopedSpan final {
+  public:
+    /**
+     * @brief Construct a new ScopedSpan object and start the span.
+     *
+     * @param name Name of the span (e.g., "parse"). It must be a string literal, since only the pointer is stored.
+     */
+    explicit ScopedSpan(const char *name);
+
+    /**
+     * @brief Construct a new ScopedSpan object for a file and start the span. The path is shown as an argument of the span.
+     *
+     * @param name Name of the span (e.g., "file"). It must be a string literal, since only the pointer is stored.
+     * @param path Path to the file (e.g., "~/src/app.cpp"). It must outlive this object.
+     */
+    explicit ScopedSpan(const char *name,
+                        const std::filesystem::path &path);
+
+    /**
+     * @brief Destroy the ScopedSpan object and record the span.
+     */
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan &) = delete;
+    ScopedSpan &operator=(const ScopedSpan &) = delete;
+
+  private:
+    /**
+     * @brief Name of the span.
+     */
+    const char *name_;
+
+    /**
+     * @brief Path to the file, or nullptr if the span is not about a file.
+     */
+    const std::filesystem::path *path_;
+
+    /**
+     * @brief If true, recording was enabled on construction, so the destructor has to record the span.
+     */
+    const bool active_;
+
+    /**
+     * @brief Time at which the span started.
+     */
+    const std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Write the spans of all threads to a JSON file in the Chrome trace-event format.
+ *
+ * Each thread is shown as its own track, numbered in order of the threads' first recording. The timestamps are in microseconds since the last reset.
+ *
+ * @param output_path Path to the JSON file (e.g., "~/trace.json").
+ *
+ * @throws std::runtime_error If the file cannot be written.
+ *
+ * @note This must not be called while other threads are recording.
+ */
+void write(const std::filesystem::path &output_path);
+
+}  // namespace core::trace
@@ -0,0 +1,86 @@
+/**
+ * @file aggregate.cpp
+ */
+
+#include <algorithm>      // for std::sort, std::min
+#include <cstddef>        // for std::size_t
+#include <string>         // for std::string
+#include <unordered_map>  // for std::unordered_map
+#include <unordered_set>  // for std::unordered_set
+#include <vector>         // for std::vector
+
+#include "aggregate.hpp"
+#include "core/symbols.hpp"
+#include "modules/analyze.hpp"
+
+namespace modules::aggregate {
+
+SymbolCounter::SymbolCounter(const std::size_t shard_count)
+    : shards_(shard_count) {}
+
+void SymbolCounter::add(const std::size_t shard,
+                        const analyze::CodeParser &parser)
+{
+    Shard &target = this->shards_[shard];
+
+    // Count every unlisted occurrence, but each file only once per function
+    std::unordered_set<core::symbols::Id> seen;
+    for (const auto function : parser.get_unlisted_functions().get_functions()) {
+        Tally &tally = target.unlisted[function];
+        ++tally.occurrences;
+        if (seen.insert(function).second) {
+            ++tally.files;
+        }
+    }
+
+    // Count every stale listing, but each file only once per function
+    seen.clear();
+    for (const auto &entry : parser.get_unused_functions()) {
+        for (const auto &name : entry.unused_functions) {
+            const core::symbols::Id function = core::symbols::intern(name);
+            Tally &tally = target.unused[function];
+            ++tally.occurrences;
+            if (seen.insert(function).second) {
+                ++tally.files;
+            }
+        }
+    }
+}
+
+std::vector<Count> SymbolCounter::get_top_unlisted(const std::size_t limit) const
+{
+    return this->merge(&Shard::unlisted, limit);
+}
+
+std::vector<Count> SymbolCounter::get_top_unused(const std::size_t limit) const
+{
+    return this->merge(&Shard::unused, limit);
+}
+
+std::vector<Count> SymbolCounter::merge(std::unordered_map<core::symbols::Id, Tally> Shard::*member,
+                                        const std::size_t limit) const
+{
+    // Merge the shards into a single map
+    std::unordered_map<core::symbols::Id, Tally> merged;
+    for (const auto &shard : this->shards_) {
+        for (const auto &[function, tally] : shard.*member) {
+            Tally &total = merged[function];
+            total.occurrences += tally.occurrences;
+            total.files += tally.files;
+        }
+    }
+
+    // Sort by occurrences in descending order, use the name as a tie-breaker for a deterministic order, the names are only resolved here
+    std::vector<Count> counts;
+    counts.reserve(merged.size());
+    for (const auto &[function, tally] : merged) {
+        counts.push_back({std::string(core::symbols::get_name(function)), tally.occurrences, tally.files});
+    }
+    std::sort(counts.begin(), counts.end(), [](const Count &a, const Count &b) {
+        return a.occurrences != b.occurrences ? a.occurrences > b.occurrences : a.function < b.function;
+    });
+    counts.resize(std::min(limit, counts.size()));
+    return counts;
+}
+
+}  // namespace modules::aggregate
@@ -0,0 +1,118 @@
+/**
+ * @file aggregate.hpp
+ *
+ * @brief Aggregate findings across all files of a project.
+ */
+
+#pragma once
+
+#include <cstddef>        // for std::size_t
+#include <string>         // for std::string
+#include <unordered_map>  // for std::unordered_map
+#include <vector>         // for std::vector
+
+#include "core/symbols.hpp"
+#include "modules/analyze.hpp"
+
+namespace modules::aggregate {
+
+/**
+ * @brief Struct that represents how often a function was reported across the project.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Count final {
+    /**
+     * @brief Function prefixed with "std::" (e.g., "std::size_t").
+     */
+    std::string function;
+
+    /**
+     * @brief Number of times the function was reported (e.g., "120").
+     */
+    std::size_t occurrences;
+
+    /**
+     * @brief Number of files in which the function was reported (e.g., "34").
+     */
+    std::size_t files;
+};
+
+/**
+ * @brief Class that counts unlisted and unused functions across many files without serializing the threads.
+ *
+ * Each thread writes to its own shard, so no locking is needed while files are processed. The shards are merged only when the results are requested.
+ *
+ * @note This class is marked as `final` to prevent inheritance. Each shard must only be used by one thread at a time, and the results must only be requested after all threads are done.
+ */
+class SymbolCounter final {
+  public:
+    /**
+     * @brief Construct a new SymbolCounter object.
+     *
+     * @param shard_count Number of shards, one per thread that may call "add" (e.g., "9" for 8 worker threads and the main thread).
+     */
+    explicit SymbolCounter(const std::size_t shard_count);
+
+    /**
+     * @brief Count the unlisted and unused functions of a parsed file.
+     *
+     * @param shard Index of the calling thread's shard (e.g., "0"). It must be less than the shard count.
+     * @param parser Parsed file.
+     */
+    void add(const std::size_t shard,
+             const analyze::CodeParser &parser);
+
+    /**
+     * @brief Get the most frequently unlisted functions.
+     *
+     * @param limit Maximum number of functions to return (e.g., "10").
+     *
+     * @return Vector of counts, sorted by occurrences in descending order, then by name.
+     */
+    [[nodiscard]] std::vector<Count> get_top_unlisted(const std::size_t limit) const;
+
+    /**
+     * @brief Get the most frequently unused (stale) listed functions.
+     *
+     * @param limit Maximum number of functions to return (e.g., "10").
+     *
+     * @return Vector of counts, sorted by occurrences in descending order, then by name.
+     */
+    [[nodiscard]] std::vector<Count> get_top_unused(const std::size_t limit) const;
+
+  private:
+    /**
+     * @brief Struct that represents the running totals of a single function.
+     */
+    struct Tally final {
+        std::size_t occurrences = 0;
+        std::size_t files = 0;
+    };
+
+    /**
+     * @brief Struct that represents the counts of a single thread, keyed by interned function, so that counting never allocates a name. It is aligned to a cache line, so that threads do not invalidate each other's caches.
+     */
+    struct alignas(64) Shard final {
+        std::unordered_map<core::symbols::Id, Tally> unlisted;
+        std::unordered_map<core::symbols::Id, Tally> unused;
+    };
+
+    /**
+     * @brief Merge a map of every shard and return the top entries.
+     *
+     * @param member Pointer to the map to merge (e.g., "&Shard::unlisted").
+     * @param limit Maximum number of functions to return (e.g., "10").
+     *
+     * @return Vector of counts, sorted by occurrences in descending order, then by name.
+     */
+    [[nodiscard]] std::vector<Count> merge(std::unordered_map<core::symbols::Id, Tally> Shard::*member,
+                                           const std::size_t limit) const;
+
+    /**
+     * @brief Vector of shards, one per thread.
+     */
+    std::vector<Shard> shards_;
+};
+
+}  // namespace modules::aggregate
@@ -2,17 +2,26 @@
  * @file analyze.cpp
  */
 
-#include <algorithm>      // for std::transform
-#include <filesystem>     // for std::filesystem
-#include <iterator>       // for std::back_inserter
-#include <regex>          // for std::regex, std::smatch, std::sregex_iterator, std::regex_search
-#include <string>         // for std::string
-#include <unordered_set>  // for std::unordered_set
-#include <vector>         // for std::vector
+#include <algorithm>        // for std::any_of, std::find, std::find_if_not, std::lower_bound, std::transform
+#include <cctype>           // for std::isalnum, std::isspace, std::tolower
+#include <cstddef>          // for std::size_t, std::byte
+#include <cstdint>          // for std::uint32_t
+#include <filesystem>       // for std::filesystem
+#include <memory_resource>  // for std::pmr::monotonic_buffer_resource
+#include <regex>            // for std::regex, std::cmatch, std::regex_search
+#include <string>           // for std::string, std::pmr::string
+#include <string_view>      // for std::string_view
+#include <unordered_map>    // for std::pmr::unordered_map
+#include <unordered_set>    // for std::unordered_set, std::pmr::unordered_set
+#include <utility>          // for std::move
+#include <vector>           // for std::vector, std::pmr::vector
 
 #include "analyze.hpp"
 #include "core/io.hpp"
+#include "core/stats.hpp"
+#include "core/stdlib.hpp"
 #include "core/string.hpp"
+#include "core/symbols.hpp"
 
 namespace modules::analyze {
 
@@ -40,21 +49,213 @@ namespace {
         (!line.empty() && line.at(0) == '*');
 }
 
+/**
+ * @brief Private helper function to check if a character is a word character, like "\w" in a regular expression.
+ *
+ * @param ch Character to check (e.g., "_").
+ *
+ * @return True if the character is alphanumeric or an underscore, false otherwise.
+ */
+[[nodiscard]] bool is_word_character(const char ch)
+{
+    return std::isalnum(static_cast<unsigned char>(ch)) != 0 || ch == '_';
+}
+
+/**
+ * @brief Struct that represents the scratch state of a thread, which persists across the files that it parses.
+ *
+ * Every member is cleared before use but keeps its capacity, so that once a thread has parsed a few files, parsing a typical file does not grow any of them again. The arena buffer backs the per-file arena of the parser's temporaries, which are taken from the global allocator instead if they do not fit.
+ *
+ * @note This struct is marked as `final` to prevent inheritance. Only one parser may use it at a time, i.e., a parser must not be constructed while another one is being constructed on the same thread.
+ */
+struct Scratch final {
+    std::vector<std::byte> arena_buffer = std::vector<std::byte>(256 * 1024);  // Buffer of the per-file arena
+    core::io::LineReader lines;                                                 // Lines of the current file
+    std::string processed_line;                                                 // Current line, stripped, lowercased and without comment
+};
+
+/**
+ * @brief Private helper function to get the scratch state of the calling thread.
+ *
+ * @return Scratch state of the calling thread, created on the first call.
+ */
+[[nodiscard]] Scratch &get_scratch()
+{
+    thread_local Scratch scratch;
+    return scratch;
+}
+
+/**
+ * @brief Private helper function to strip leading and trailing whitespace from a line and convert it to lowercase, reusing the capacity of the output.
+ *
+ * This is equivalent to "core::string::to_lower(core::string::strip_whitespace(line))", without allocating a new string for each line.
+ *
+ * @param line Original line text (e.g., "  STD::SORT(V.BEGIN(), V.END());").
+ * @param output String to store the result in (e.g., "std::sort(v.begin(), v.end());").
+ */
+void assign_processed(const std::string_view line,
+                      std::string &output)
+{
+    const auto is_space = [](const unsigned char ch) { return std::isspace(ch) != 0; };
+    const auto start = std::find_if_not(line.cbegin(), line.cend(), is_space);
+    const auto end = std::find_if_not(line.crbegin(), line.crend(), is_space).base();
+    output.assign(start, start < end ? end : start);
+    std::transform(output.cbegin(), output.cend(), output.begin(),
+                   [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+}
+
 }  // namespace
 
-CodeParser::CodeParser(const std::filesystem::path &input_path)
+void FunctionTable::add(const std::uint32_t number,
+                        const core::symbols::Id function,
+                        const Occurrence::Kind kind)
+{
+    this->numbers_.emplace_back(number);
+    this->functions_.emplace_back(function);
+    this->kinds_.emplace_back(kind);
+}
+
+std::size_t FunctionTable::size() const
+{
+    return this->functions_.size();
+}
+
+bool FunctionTable::empty() const
+{
+    return this->functions_.empty();
+}
+
+Occurrence FunctionTable::get(const std::size_t index) const
+{
+    return Occurrence(this->numbers_[index], this->functions_[index], this->kinds_[index]);
+}
+
+const std::vector<std::uint32_t> &FunctionTable::get_numbers() const
+{
+    return this->numbers_;
+}
+
+const std::vector<core::symbols::Id> &FunctionTable::get_functions() const
+{
+    return this->functions_;
+}
+
+const std::vector<Occurrence::Kind> &FunctionTable::get_kinds() const
+{
+    return this->kinds_;
+}
+
+void UnlistedFunctionTable::add(const std::uint32_t number,
+                                const core::symbols::Id function)
+{
+    this->numbers_.emplace_back(number);
+    this->functions_.emplace_back(function);
+}
+
+void UnlistedFunctionTable::remove(const std::unordered_set<core::symbols::Id> &functions)
+{
+    // Compact the columns in place, moving each kept unlisted function forward
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < this->functions_.size(); ++i) {
+        if (functions.find(this->functions_[i]) == functions.cend()) {
+            this->numbers_[kept] = this->numbers_[i];
+            this->functions_[kept] = this->functions_[i];
+            ++kept;
+        }
+    }
+    this->numbers_.resize(kept);
+    this->functions_.resize(kept);
+}
+
+std::size_t UnlistedFunctionTable::size() const
+{
+    return this->functions_.size();
+}
+
+bool UnlistedFunctionTable::empty() const
+{
+    return this->functions_.empty();
+}
+
+UnlistedFunction UnlistedFunctionTable::get(const std::size_t index) const
+{
+    return UnlistedFunction(this->numbers_[index], this->functions_[index]);
+}
+
+const std::vector<std::uint32_t> &UnlistedFunctionTable::get_numbers() const
+{
+    return this->numbers_;
+}
+
+const std::vector<core::symbols::Id> &UnlistedFunctionTable::get_functions() const
+{
+    return this->functions_;
+}
+
+std::string_view find_include_directive(const std::string_view processed_line)
 {
     // Regular expression to match include directives, e.g., "#include <iostream>"
     static const std::regex include_directive_regex(R"(^\s*#include\s*<\S+>)", std::regex::optimize);
-    // Regular expression to match any std:: identifier, e.g., "std::cout"
-    static const std::regex std_identifier_regex(R"(std::(\w+))", std::regex::optimize);
+    // Match results, reused for each line, so that matching does not allocate once the thread has matched a line
+    thread_local std::cmatch match;
+
+    // The line is stripped, so it has to begin with "#"
+    if (processed_line.compare(0, 1, "#") != 0 ||
+        !std::regex_search(processed_line.data(), processed_line.data() + processed_line.size(), match, include_directive_regex)) {
+        return {};
+    }
+    return processed_line.substr(static_cast<std::size_t>(match.position(0)), static_cast<std::size_t>(match.length(0)));
+}
+
+std::string_view get_include_header(const std::string_view include_directive)
+{
+    const std::size_t header_start = include_directive.find('<') + 1;
+    return include_directive.substr(header_start, include_directive.find('>', header_start) - header_start);
+}
+
+CodeParser::CodeParser(const std::filesystem::path &input_path)
+{
+    // Charge the parser to the parse phase, reading the file is charged to the read phase by "LineReader::load"
+    const core::stats::ScopedPhase parse_phase(core::stats::Phase::Parse);
+
+    // Regular expression to match quoted include directives on the original line, e.g., '#include "core/io.hpp"'
+    static const std::regex quoted_include_regex(R"re(^\s*#\s*include\s*"([^"]+)")re", std::regex::optimize | std::regex::icase);
+
+    // Per-file arena for the temporaries below, everything allocated from it is released when the constructor returns
+    Scratch &scratch = get_scratch();
+    std::pmr::monotonic_buffer_resource arena(scratch.arena_buffer.data(), scratch.arena_buffer.size());
+
+    // Temporary records, they refer to the loaded lines instead of copying them
+    struct ListedInclude {
+        std::size_t number;                            // Original line number
+        std::string_view text;                         // Original line text
+        std::pmr::vector<std::pmr::string> functions;  // Functions listed in the comment
+    };
+    struct UsedEntity {
+        std::size_t number;         // Original line number
+        std::string_view text;      // Original line text
+        std::pmr::string function;  // Function used in the code
+        core::symbols::Id id;       // Interned function
+    };
+    struct AngleInclude {
+        std::size_t number;       // Original line number
+        std::string_view text;    // Original line text
+        std::string_view header;  // Header without angle brackets, owned by "include_headers"
+    };
 
     // Temporary containers to store parsed data
-    std::vector<IncludeWithUnusedFunctions> temp_includes_with_functions;  // Include directives with listed functions
-    std::vector<UnlistedFunction> temp_std_entities;                       // All std:: identifiers used in the code
+    std::pmr::vector<ListedInclude> temp_includes_with_functions(&arena);             // Include directives with listed functions
+    std::pmr::vector<UsedEntity> temp_std_entities(&arena);                           // All std:: identifiers used in the code
+    std::pmr::vector<AngleInclude> temp_angle_includes(&arena);                       // Include directives that may be redundant
+    std::pmr::unordered_map<std::size_t, std::pmr::string> include_headers(&arena);  // Headers of all include directives, keyed by line number
+    std::pmr::vector<std::pmr::string> std_identifiers(&arena);                       // std:: identifiers of the current line, reused for each line
 
-    // Load the file from disk and iterate over each line
-    for (const auto &[line_number, line_text] : core::io::read_lines(input_path)) {
+    // Load the file from disk into the thread's line reader and iterate over each line, the records refer to the loaded lines
+    const core::io::LineReader &lines = scratch.lines;
+    scratch.lines.load(input_path);
+    std::string &processed_line = scratch.processed_line;
+    for (std::size_t line_number = 1; line_number <= lines.size(); ++line_number) {
+        const std::string_view line_text = lines.get(line_number);
 
         // Skip if the raw line is empty (avoid unnecessary processing)
         if (line_text.empty()) {
@@ -62,63 +263,96 @@ CodeParser::CodeParser(const std::filesystem::path &input_path)
         }
 
         // Strip leading and trailing whitespace and convert to lowercase
-        std::string processed_line = core::string::to_lower(core::string::strip_whitespace(line_text));
+        assign_processed(line_text, processed_line);
 
         // Skip the line if it begins with a comment
         if (begins_with_comment(processed_line)) {
             continue;
         }
 
-        // Variables to hold match results
-        std::string include_directive;
-        std::smatch include_match;
-
-        // Check if the line contains an include directive
-        const bool line_contains_include = std::regex_search(processed_line, include_match, include_directive_regex);
-        if (line_contains_include) {
-            // Extract the include directive (e.g., "#include <iostream>")
-            include_directive = include_match.str(0);
-        }
-        else {
+        // Check if the line contains an include directive (e.g., "#include <iostream>")
+        // The include directive refers to the processed line, which is not changed for include directives
+        const std::string_view include_directive = find_include_directive(processed_line);
+        const bool line_contains_include = !include_directive.empty();
+        if (const std::size_t comment = processed_line.find("//"); !line_contains_include && comment != std::string::npos) {
             // If not an include directive, remove inline comments to prevent false positives
             // E.g., "int x = 5; // Use std::cout to print it" becomes "int x = 5;", so we don't match "std::cout" later
-            processed_line = core::string::remove_comment(processed_line);
+            processed_line.erase(comment);
         }
 
-        // Find all std:: identifiers in the processed line
-        std::vector<std::string> std_identifiers;
-        std::sregex_iterator begin(processed_line.cbegin(), processed_line.cend(), std_identifier_regex), end;
-        std::transform(begin, end, std::back_inserter(std_identifiers),
-                       [](const std::smatch &match) { return match.str(0); });
+        // Find all std:: identifiers in the processed line, i.e., "std::" followed by word characters (e.g., "std::cout"), or a "std::pmr::" alias
+        // This scans like the regular expression "std::(\w+)" would, but without the allocations of a regex search
+        std_identifiers.clear();
+        for (std::size_t start = processed_line.find("std::"); start != std::string::npos; start = processed_line.find("std::", start + 1)) {
+            std::size_t end = start + 5;
+            while (end < processed_line.size() && is_word_character(processed_line[end])) {
+                ++end;
+            }
+            // Each polymorphic allocator alias is provided by the header of its container, so the alias is kept with its namespace (e.g., "std::pmr::vector")
+            if (end == start + 8 && processed_line.compare(start + 5, 3, "pmr") == 0 && processed_line.compare(end, 2, "::") == 0) {
+                std::size_t alias_end = end + 2;
+                while (alias_end < processed_line.size() && is_word_character(processed_line[alias_end])) {
+                    ++alias_end;
+                }
+                if (alias_end > end + 2) {
+                    end = alias_end;
+                }
+            }
+            if (end > start + 5) {
+                std_identifiers.emplace_back(processed_line.data() + start, end - start);
+                // Continue after the identifier, matches do not overlap
+                start = end - 1;
+            }
+        }
+
+        // Remember the included header, unless a comment lists something other than standard functions (e.g., "// for EXIT_SUCCESS")
+        if (line_contains_include) {
+            const auto &stored_header = include_headers.try_emplace(line_number, get_include_header(include_directive)).first->second;
+            if (!std_identifiers.empty() || processed_line.find("//") == std::string::npos) {
+                temp_angle_includes.push_back({line_number, line_text, stored_header});
+            }
+        }
 
         // Categorize the line based on its content
         if (line_contains_include && !std_identifiers.empty()) {
             // Line is an include directive with std:: identifiers in comments
             // E.g., "#include <iostream> // for std::cout, std::cerr"
-            temp_includes_with_functions.emplace_back(line_number, line_text, std_identifiers);
+            for (const auto &identifier_name : std_identifiers) {
+                this->occurrences_.add(static_cast<std::uint32_t>(line_number), core::symbols::intern(identifier_name), Occurrence::Kind::Listed);
+            }
+            temp_includes_with_functions.push_back({line_number, line_text, std::pmr::vector<std::pmr::string>(std_identifiers, &arena)});
         }
         else if (line_contains_include) {
             // Line is an include directive without any std:: identifiers
             // E.g., "#include <string>"
-            this->bare_includes_.emplace_back(line_number, line_text, include_directive);
+            this->bare_includes_.emplace_back(line_number, std::string(line_text), std::string(include_directive));
         }
         else if (!std_identifiers.empty()) {
             // Line contains std:: identifiers used in the code
             // E.g., identifier "std::string" in line "std::string name;".
-            for (const auto &identifier_name : std_identifiers) {
-                // Do not create C++ reference links yet, we''ll do that later
-                temp_std_entities.emplace_back(line_number, line_text, identifier_name, "");
+            for (auto &identifier_name : std_identifiers) {
+                // Intern the function once, both the occurrence and a possible unlisted function refer to it
+                const core::symbols::Id id = core::symbols::intern(identifier_name);
+                this->occurrences_.add(static_cast<std::uint32_t>(line_number), id, Occurrence::Kind::Used);
+                temp_std_entities.push_back({line_number, line_text, std::move(identifier_name), id});
             }
         }
+        else if (std::cmatch quoted_match; processed_line.compare(0, 1, "#") == 0 &&
+                                           std::regex_search(line_text.data(), line_text.data() + line_text.size(), quoted_match, quoted_include_regex)) {
+            // Line is a quoted include directive, keep the path with its original case
+            // E.g., "core/io.hpp" in line '#include "core/io.hpp"'
+            this->quoted_includes_.emplace_back(quoted_match.str(1));
+        }
         // Lines that don't match any of the above are ignored
-        // E.g., '#include "my_header.hpp"'
     }
 
     // --- EXTRACT UNUSED FUNCTIONS ---
-    // Create a set of all std:: identifiers used in the code for quick lookup
-    std::unordered_set<std::string> used_std_identifiers;
+    // Create a set of all std:: identifiers used in the code for quick lookup, the views refer to the records
+    std::pmr::unordered_set<std::string_view> used_functions(&arena);
     for (const auto &entity_in_file : temp_std_entities) {
-        used_std_identifiers.insert(entity_in_file.function);
+        if (used_functions.insert(entity_in_file.function).second) {
+            this->used_functions_.emplace(entity_in_file.function);
+        }
     }
 
     // Identify unused functions listed in include directives
@@ -128,8 +362,8 @@ CodeParser::CodeParser(const std::filesystem::path &input_path)
         std::vector<std::string> functions_not_referenced;
 
         // Check each function listed in the include directive
-        for (const auto &func : include_with_functions.unused_functions) {
-            if (used_std_identifiers.find(func) == used_std_identifiers.cend()) {
+        for (const auto &func : include_with_functions.functions) {
+            if (used_functions.find(func) == used_functions.cend()) {
                 // Function is listed but not used; add it to the list
                 functions_not_referenced.emplace_back(func);
             }
@@ -137,24 +371,96 @@ CodeParser::CodeParser(const std::filesystem::path &input_path)
 
         // If there are any unused functions, add them to the unused_functions_ vector
         if (!functions_not_referenced.empty()) {
-            this->unused_functions_.emplace_back(include_with_functions.number, include_with_functions.text, functions_not_referenced);
+            this->unused_functions_.emplace_back(include_with_functions.number, std::string(include_with_functions.text), functions_not_referenced);
+        }
+    }
+
+    // --- EXTRACT REDUNDANT INCLUDES ---
+    // Create a set of all headers that provide at least one used function
+    std::pmr::unordered_set<std::string_view> provided_headers(&arena);
+    for (const auto function : used_functions) {
+        for (const auto header : core::stdlib::find_headers(function)) {
+            provided_headers.insert(header);
+        }
+    }
+
+    // Create a set of all include directives that list at least one used function
+    std::pmr::unordered_set<std::size_t> includes_with_used_functions(&arena);
+    for (const auto &include_with_functions : temp_includes_with_functions) {
+        if (std::any_of(include_with_functions.functions.cbegin(), include_with_functions.functions.cend(),
+                        [&used_functions](const std::pmr::string &func) { return used_functions.find(func) != used_functions.cend(); })) {
+            includes_with_used_functions.insert(include_with_functions.number);
+        }
+    }
+
+    // Identify standard headers that provide no used function and list no used function
+    for (const auto &include : temp_angle_includes) {
+        if (core::stdlib::is_known_header(include.header) &&
+            provided_headers.find(include.header) == provided_headers.cend() &&
+            includes_with_used_functions.find(include.number) == includes_with_used_functions.cend()) {
+            this->redundant_includes_.emplace_back(include.number, std::string(include.text), std::string(include.header));
+        }
+    }
+
+    // --- EXTRACT MISATTRIBUTED FUNCTIONS ---
+    // Check each function listed after a known standard header against the headers that provide it
+    for (const auto &include_with_functions : temp_includes_with_functions) {
+        const std::pmr::string &header = include_headers.at(include_with_functions.number);
+        if (!core::stdlib::is_known_header(header)) {
+            continue;
+        }
+        for (const auto &func : include_with_functions.functions) {
+            const auto headers = core::stdlib::find_headers(func);
+            if (!headers.empty()) {
+                // Known function listed after a header that does not provide it, suggest the preferred header
+                if (std::find(headers.cbegin(), headers.cend(), header) == headers.cend()) {
+                    this->misattributed_functions_.emplace_back(include_with_functions.number, std::string(include_with_functions.text), std::string(func), std::string(header),
+                                                                MisattributedFunction::Kind::WrongHeader, std::string(headers.front()));
+                }
+            }
+            else if (used_functions.find(func) == used_functions.cend()) {
+                // Unknown function that is not used either, likely a typo, suggest the closest known function within 2 edits
+                std::string suggestion;
+                std::size_t best_distance = 3;
+                for (const auto &known_function : core::stdlib::get_known_functions()) {
+                    // Skip functions whose length alone rules them out, before computing the distance
+                    const std::size_t length_difference = known_function.size() > func.size() ? known_function.size() - func.size() : func.size() - known_function.size();
+                    if (length_difference >= best_distance) {
+                        continue;
+                    }
+                    if (const std::size_t distance = core::string::edit_distance(func, known_function); distance < best_distance) {
+                        best_distance = distance;
+                        suggestion = known_function;
+                    }
+                }
+                if (!suggestion.empty()) {
+                    this->misattributed_functions_.emplace_back(include_with_functions.number, std::string(include_with_functions.text), std::string(func), std::string(header),
+                                                                MisattributedFunction::Kind::UnknownFunction, suggestion);
+                }
+            }
         }
     }
 
     // --- EXTRACT MISSING FUNCTIONS ---
-    // Create a set of all functions listed in include directives
-    std::unordered_set<std::string> functions_in_include_directives;
+    // Create a set of all functions listed in include directives, the views refer to the records
+    std::pmr::unordered_set<std::string_view> listed_functions(&arena);
     for (const auto &include_with_functions : temp_includes_with_functions) {
-        functions_in_include_directives.insert(include_with_functions.unused_functions.cbegin(), include_with_functions.unused_functions.cend());
+        for (const auto &func : include_with_functions.functions) {
+            if (listed_functions.insert(func).second) {
+                this->listed_functions_.emplace(func);
+            }
+        }
     }
 
     // Identify functions used in the code but not listed in any include directive's comments
     for (const auto &entity_in_file : temp_std_entities) {
-        if (functions_in_include_directives.find(entity_in_file.function) == functions_in_include_directives.cend()) {
-            // Function is used but not listed; add it to the unlisted_functions_ vector
-            // Also, create a link to the C++ reference for the function
-            this->unlisted_functions_.emplace_back(entity_in_file.number, entity_in_file.text, entity_in_file.function,
-                                                   core::string::create_cpp_reference_link(entity_in_file.function));
+        if (listed_functions.find(entity_in_file.function) == listed_functions.cend()) {
+            // Function is used but not listed; add it to the unlisted_functions_ table
+            // Keep the line text once per line, the link to the C++ reference is only created when the finding is printed
+            this->unlisted_functions_.add(static_cast<std::uint32_t>(entity_in_file.number), entity_in_file.id);
+            if (this->lines_.empty() || this->lines_.back().number != entity_in_file.number) {
+                this->lines_.emplace_back(entity_in_file.number, std::string(entity_in_file.text));
+            }
         }
     }
 }
@@ -169,9 +475,67 @@ const std::vector<IncludeWithUnusedFunctions> &CodeParser::get_unused_functions(
     return this->unused_functions_;
 }
 
-const std::vector<UnlistedFunction> &CodeParser::get_unlisted_functions() const
+const UnlistedFunctionTable &CodeParser::get_unlisted_functions() const
 {
     return this->unlisted_functions_;
 }
 
+const std::vector<RedundantInclude> &CodeParser::get_redundant_includes() const
+{
+    return this->redundant_includes_;
+}
+
+const std::vector<MisattributedFunction> &CodeParser::get_misattributed_functions() const
+{
+    return this->misattributed_functions_;
+}
+
+const std::vector<std::string> &CodeParser::get_quoted_includes() const
+{
+    return this->quoted_includes_;
+}
+
+const std::unordered_set<std::string> &CodeParser::get_listed_functions() const
+{
+    return this->listed_functions_;
+}
+
+const std::unordered_set<std::string> &CodeParser::get_used_functions() const
+{
+    return this->used_functions_;
+}
+
+std::string_view CodeParser::get_line(const std::size_t number) const
+{
+    const auto it = std::lower_bound(this->lines_.cbegin(), this->lines_.cend(), number,
+                                     [](const core::io::Line &line, const std::size_t value) { return line.number < value; });
+    if (it == this->lines_.cend() || it->number != number) {
+        return {};
+    }
+    return it->text;
+}
+
+const FunctionTable &CodeParser::get_occurrences() const
+{
+    return this->occurrences_;
+}
+
+void CodeParser::inherit_listed_functions(const std::unordered_set<std::string> &functions)
+{
+    // Nothing to do if no functions are inherited
+    if (functions.empty()) {
+        return;
+    }
+
+    // Remember the inherited functions, so that they are treated as listed from now on
+    this->listed_functions_.insert(functions.cbegin(), functions.cend());
+
+    // Remove the unlisted functions that are listed in the inherited set, comparing the interned IDs
+    std::unordered_set<core::symbols::Id> inherited;
+    for (const auto &function : functions) {
+        inherited.insert(core::symbols::intern(function));
+    }
+    this->unlisted_functions_.remove(inherited);
+}
+
 }  // namespace modules::analyze
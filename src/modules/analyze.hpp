@@ -6,12 +6,17 @@
 
 #pragma once
 
-#include <cstddef>     // for std::size_t
-#include <filesystem>  // for std::filesystem
-#include <string>      // for std::string
-#include <vector>      // for std::vector
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint8_t, std::uint32_t
+#include <filesystem>     // for std::filesystem
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <unordered_set>  // for std::unordered_set
+#include <vector>         // for std::vector
 
 #include "core/io.hpp"
+#include "core/string.hpp"
+#include "core/symbols.hpp"
 
 namespace modules::analyze {
 
@@ -79,48 +84,393 @@ struct IncludeWithUnusedFunctions final : public core::io::Line {
     const std::vector<std::string> unused_functions;
 };
 
+/**
+ * @brief Struct that represents a single redundant include directive, i.e., a standard header that provides none of the functions used in the code.
+ *
+ * E.g., "#include <map>  // for std::map" where "std::map" is not used in the code, and no other used function is provided by <map>.
+ *
+ * @note This struct is marked as `final` to prevent inheritance. Only headers in the compiled symbol-to-header table are checked, and include directives with comments that list no standard functions (e.g., "// for EXIT_SUCCESS") are skipped, since they usually provide macros.
+ */
+struct RedundantInclude final : public core::io::Line {
+    /**
+     * @brief Construct a new RedundantInclude object.
+     *
+     * @param _number Original line number (e.g., "11").
+     * @param _text Original line text where the include directive was found (e.g., "#include <map>  // for std::map").
+     * @param _header Included header in lowercase, without angle brackets (e.g., "map").
+     */
+    explicit RedundantInclude(const std::size_t _number,
+                              const std::string &_text,
+                              const std::string &_header)
+        : core::io::Line(_number, _text),
+          header(_header) {}
+
+    [[nodiscard]] bool operator==(const RedundantInclude &other) const
+    {
+        return number == other.number && text == other.text && header == other.header;
+    }
+
+    /**
+     * @brief Included header in lowercase, without angle brackets (e.g., "map").
+     */
+    const std::string header;
+};
+
+/**
+ * @brief Struct that represents a single function listed as a comment after a standard include directive that does not provide it.
+ *
+ * E.g., "#include <vector>  // for std::sort", where "std::sort" is provided by <algorithm>, or "#include <algorithm>  // for std::trasform", where "std::trasform" is a typo of "std::transform".
+ *
+ * @note This struct is marked as `final` to prevent inheritance. Only headers in the compiled symbol-to-header table are checked. Unknown functions are only reported if a known function is within 2 edits, since the table is not exhaustive.
+ */
+struct MisattributedFunction final : public core::io::Line {
+    /**
+     * @brief Enum that represents why the function is misattributed.
+     */
+    enum class Kind : std::uint8_t {
+        WrongHeader,     // Known function listed after a header that does not provide it, the suggestion is the preferred header (e.g., "algorithm")
+        UnknownFunction  // Unknown function that is not used in the code, the suggestion is the closest known function (e.g., "std::transform")
+    };
+
+    /**
+     * @brief Construct a new MisattributedFunction object.
+     *
+     * @param _number Original line number (e.g., "11").
+     * @param _text Original line text where the include directive was found (e.g., "#include <vector>  // for std::sort").
+     * @param _function Misattributed function, prefixed with "std::" (e.g., "std::sort").
+     * @param _header Included header in lowercase, without angle brackets (e.g., "vector").
+     * @param _kind Why the function is misattributed (e.g., "Kind::WrongHeader").
+     * @param _suggestion Preferred header or closest known function, depending on the kind (e.g., "algorithm").
+     */
+    explicit MisattributedFunction(const std::size_t _number,
+                                   const std::string &_text,
+                                   const std::string &_function,
+                                   const std::string &_header,
+                                   const Kind _kind,
+                                   const std::string &_suggestion)
+        : core::io::Line(_number, _text),
+          function(_function),
+          header(_header),
+          kind(_kind),
+          suggestion(_suggestion) {}
+
+    [[nodiscard]] bool operator==(const MisattributedFunction &other) const
+    {
+        return number == other.number && text == other.text && function == other.function && header == other.header && kind == other.kind && suggestion == other.suggestion;
+    }
+
+    /**
+     * @brief Misattributed function, prefixed with "std::" (e.g., "std::sort").
+     */
+    const std::string function;
+
+    /**
+     * @brief Included header in lowercase, without angle brackets (e.g., "vector").
+     */
+    const std::string header;
+
+    /**
+     * @brief Why the function is misattributed (e.g., "Kind::WrongHeader").
+     */
+    const Kind kind;
+
+    /**
+     * @brief Preferred header for "Kind::WrongHeader" (e.g., "algorithm"), closest known function for "Kind::UnknownFunction" (e.g., "std::transform").
+     */
+    const std::string suggestion;
+};
+
+/**
+ * @brief Struct that represents a single occurrence of a standard function, either used in the code or listed as a comment after an include directive.
+ *
+ * Every occurrence is kept so that a project-wide symbol index can be built.
+ *
+ * @note This struct is marked as `final` to prevent inheritance. The occurrences are stored column by column in a "FunctionTable", this struct is a single row of it. The line text is kept by "CodeParser::get_line" and the link is rendered on demand.
+ */
+struct Occurrence final {
+    /**
+     * @brief Enum that represents how the function occurs in the code.
+     */
+    enum class Kind : std::uint8_t {
+        Used,   // Used in the code (e.g., "std::sort(v.begin(), v.end());")
+        Listed  // Listed as a comment (e.g., "#include <algorithm>  // for std::sort")
+    };
+
+    /**
+     * @brief Construct a new Occurrence object.
+     *
+     * @param _number Original line number (e.g., "31").
+     * @param _function Interned function (e.g., the ID of "std::sort").
+     * @param _kind How the function occurs in the code (e.g., "Kind::Used").
+     */
+    explicit Occurrence(const std::uint32_t _number,
+                        const core::symbols::Id _function,
+                        const Kind _kind)
+        : number(_number),
+          function(_function),
+          kind(_kind) {}
+
+    /**
+     * @brief Get the function that occurs.
+     *
+     * @return Function prefixed with "std::" (e.g., "std::sort").
+     */
+    [[nodiscard]] std::string_view get_function() const
+    {
+        return core::symbols::get_name(function);
+    }
+
+    /**
+     * @brief Get a link to the C++ reference for the function.
+     *
+     * @return Link to the C++ reference (e.g., "https://duckduckgo.com/?q=std%3A%3Asort+site%3Acppreference.com&ia=web").
+     */
+    [[nodiscard]] std::string get_link() const
+    {
+        return core::string::create_cpp_reference_link(std::string(this->get_function()));
+    }
+
+    /**
+     * @brief Original line number (e.g., "31").
+     */
+    const std::uint32_t number;
+
+    /**
+     * @brief Interned function (e.g., the ID of "std::sort").
+     */
+    const core::symbols::Id function;
+
+    /**
+     * @brief How the function occurs in the code (e.g., "Kind::Used").
+     */
+    const Kind kind;
+};
+
+/**
+ * @brief Class that stores occurrences of standard functions as a structure of arrays, i.e., the line numbers, interned functions and kinds in separate contiguous arrays.
+ *
+ * Counting and filtering only scan the arrays they need, e.g., counting the functions reads 4 bytes per occurrence. Single occurrences can still be read as rows with "get".
+ *
+ * @note This class is marked as `final` to prevent inheritance. The arrays always have the same size, and keep the order in which the occurrences were added.
+ */
+class FunctionTable final {
+  public:
+    /**
+     * @brief Append an occurrence to the table.
+     *
+     * @param number Original line number (e.g., "31").
+     * @param function Interned function (e.g., the ID of "std::sort").
+     * @param kind How the function occurs in the code (e.g., "Occurrence::Kind::Used").
+     */
+    void add(const std::uint32_t number,
+             const core::symbols::Id function,
+             const Occurrence::Kind kind);
+
+    /**
+     * @brief Get the number of occurrences.
+     *
+     * @return Number of occurrences (e.g., "3").
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Check if the table has no occurrences.
+     *
+     * @return True if the table is empty, false otherwise.
+     */
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * @brief Get a single occurrence as a row.
+     *
+     * @param index Index of the occurrence, less than "size()" (e.g., "0").
+     *
+     * @return Occurrence at the index.
+     */
+    [[nodiscard]] Occurrence get(const std::size_t index) const;
+
+    /**
+     * @brief Get the line numbers of all occurrences.
+     *
+     * @return Const reference to a vector of line numbers, in the order of the occurrences (e.g., {3, 4}).
+     */
+    [[nodiscard]] const std::vector<std::uint32_t> &get_numbers() const;
+
+    /**
+     * @brief Get the interned functions of all occurrences.
+     *
+     * @return Const reference to a vector of interned functions, in the order of the occurrences.
+     */
+    [[nodiscard]] const std::vector<core::symbols::Id> &get_functions() const;
+
+    /**
+     * @brief Get the kinds of all occurrences.
+     *
+     * @return Const reference to a vector of kinds, in the order of the occurrences (e.g., {Occurrence::Kind::Used}).
+     */
+    [[nodiscard]] const std::vector<Occurrence::Kind> &get_kinds() const;
+
+  private:
+    /**
+     * @brief Line number of each occurrence.
+     */
+    std::vector<std::uint32_t> numbers_;
+
+    /**
+     * @brief Interned function of each occurrence.
+     */
+    std::vector<core::symbols::Id> functions_;
+
+    /**
+     * @brief Kind of each occurrence.
+     */
+    std::vector<Occurrence::Kind> kinds_;
+};
+
 /**
  * @brief Struct that represents a single unlisted standard function, i.e., a function used in the code but not listed as a comment after any include directive.
  *
  * E.g., "std::sort()" is used in the code, but the include directive "#include <algorithm> // for std::find" is missing "std::sort". It should be "#include <algorithm> // for std::find, std::sort".
  *
- * @note This struct is marked as `final` to prevent inheritance. All standard functions are stored with the "std::" prefix internally.
+ * @note This struct is marked as `final` to prevent inheritance. The unlisted functions are stored column by column in an "UnlistedFunctionTable", this struct is a single row of it. The line text is kept by "CodeParser::get_line" and the link is rendered on demand.
  */
-struct UnlistedFunction final : public core::io::Line {
+struct UnlistedFunction final {
     /**
      * @brief Construct a new UnlistedFunction object.
      *
      * @param _number Original line number (e.g., "31").
-     * @param _text Original line text where the unlisted function was found (e.g., "std::sort(result.begin(), result.end());").
-     * @param _function Unlisted function that needs to be added to include comments, prefixed with "std::" (e.g., "std::sort").
-     * @param _link Link to the C++ reference for the function (e.g., "https://duckduckgo.com/?q=std%3A%3Asort+site%3Acppreference.com&ia=web").
+     * @param _function Interned function (e.g., the ID of "std::sort").
      */
-    explicit UnlistedFunction(const std::size_t _number,
-                              const std::string &_text,
-                              const std::string &_function,
-                              const std::string &_link)
-        : core::io::Line(_number, _text),
-          function(_function),
-          link(_link) {}
+    explicit UnlistedFunction(const std::uint32_t _number,
+                              const core::symbols::Id _function)
+        : number(_number),
+          function(_function) {}
 
-    [[nodiscard]] bool operator==(const UnlistedFunction &other) const
+    /**
+     * @brief Get the unlisted function.
+     *
+     * @return Function prefixed with "std::" (e.g., "std::sort").
+     */
+    [[nodiscard]] std::string_view get_function() const
     {
-        return number == other.number && text == other.text && function == other.function && link == other.link;
+        return core::symbols::get_name(function);
     }
 
     /**
-     * @brief Unlisted function that needs to be added to include comments, prefixed with "std::" (e.g., "std::sort").
+     * @brief Get a link to the C++ reference for the function.
      *
-     * @note The "function" field stores the identifier name, which is the name of the function or object used from the "std" namespace.
+     * @return Link to the C++ reference (e.g., "https://duckduckgo.com/?q=std%3A%3Asort+site%3Acppreference.com&ia=web").
      */
-    const std::string function;
+    [[nodiscard]] std::string get_link() const
+    {
+        return core::string::create_cpp_reference_link(std::string(this->get_function()));
+    }
+
+    /**
+     * @brief Original line number (e.g., "31").
+     */
+    const std::uint32_t number;
+
+    /**
+     * @brief Interned function (e.g., the ID of "std::sort").
+     */
+    const core::symbols::Id function;
+};
+
+/**
+ * @brief Class that stores unlisted standard functions as a structure of arrays, i.e., the line numbers and interned functions in separate contiguous arrays.
+ *
+ * Unlike a "FunctionTable", it has no kinds, since every unlisted function is used in the code. Single unlisted functions can still be read as rows with "get".
+ *
+ * @note This class is marked as `final` to prevent inheritance. The arrays always have the same size, and keep the order in which the functions were added.
+ */
+class UnlistedFunctionTable final {
+  public:
+    /**
+     * @brief Append an unlisted function to the table.
+     *
+     * @param number Original line number (e.g., "31").
+     * @param function Interned function (e.g., the ID of "std::sort").
+     */
+    void add(const std::uint32_t number,
+             const core::symbols::Id function);
+
+    /**
+     * @brief Remove every occurrence of the provided functions, keeping the order of the other unlisted functions.
+     *
+     * @param functions Set of interned functions to remove.
+     */
+    void remove(const std::unordered_set<core::symbols::Id> &functions);
+
+    /**
+     * @brief Get the number of unlisted functions.
+     *
+     * @return Number of unlisted functions (e.g., "3").
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Check if the table has no unlisted functions.
+     *
+     * @return True if the table is empty, false otherwise.
+     */
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * @brief Get a single unlisted function as a row.
+     *
+     * @param index Index of the unlisted function, less than "size()" (e.g., "0").
+     *
+     * @return Unlisted function at the index.
+     */
+    [[nodiscard]] UnlistedFunction get(const std::size_t index) const;
 
     /**
-     * @brief Link to the C++ reference for the function (e.g., "https://duckduckgo.com/?q=std%3A%3Asort+site%3Acppreference.com&ia=web").
+     * @brief Get the line numbers of all unlisted functions.
+     *
+     * @return Const reference to a vector of line numbers, in the order of the unlisted functions (e.g., {3, 4}).
+     */
+    [[nodiscard]] const std::vector<std::uint32_t> &get_numbers() const;
+
+    /**
+     * @brief Get the interned functions of all unlisted functions.
+     *
+     * @return Const reference to a vector of interned functions, in the order of the unlisted functions.
+     */
+    [[nodiscard]] const std::vector<core::symbols::Id> &get_functions() const;
+
+  private:
+    /**
+     * @brief Line number of each unlisted function.
+     */
+    std::vector<std::uint32_t> numbers_;
+
+    /**
+     * @brief Interned function of each unlisted function.
      */
-    const std::string link;
+    std::vector<core::symbols::Id> functions_;
 };
 
+/**
+ * @brief Find the angle-bracket include directive at the beginning of a line.
+ *
+ * The parser and the fixer both use this function, so that they agree on which lines are include directives.
+ *
+ * @param processed_line Line stripped of leading and trailing whitespace and converted to lowercase (e.g., "#include <vector>  // for std::vector").
+ *
+ * @return Include directive, referring to the line (e.g., "#include <vector>"), or an empty view if the line is not an include directive.
+ */
+[[nodiscard]] std::string_view find_include_directive(const std::string_view processed_line);
+
+/**
+ * @brief Get the header of an include directive.
+ *
+ * @param include_directive Include directive found by "find_include_directive" (e.g., "#include <vector>").
+ *
+ * @return Header without angle brackets, referring to the include directive (e.g., "vector").
+ */
+[[nodiscard]] std::string_view get_include_header(const std::string_view include_directive);
+
 /**
  * @brief Class that extracts information from C++ code.
  *
@@ -128,8 +478,10 @@ struct UnlistedFunction final : public core::io::Line {
  * - Bare include directives (directives without any functions listed as comments).
  * - Functions that are listed in comments but unused in the code.
  * - Functions that are used in the code but not listed as comments in any include directive.
+ * - Standard include directives that provide none of the functions used in the code.
+ * - Functions listed after a standard include directive that does not provide them.
  *
- * These results are accessible via getter functions.
+ * These results are accessible via getter functions. The quoted include directives (e.g., '#include "core/io.hpp"') and the sets of listed and used functions are also kept, so that the file can serve as a summary for the files that include it.
  *
  * @note This class is marked as `final` to prevent inheritance.
  */
@@ -157,11 +509,73 @@ class CodeParser final {
     [[nodiscard]] const std::vector<IncludeWithUnusedFunctions> &get_unused_functions() const;
 
     /**
-     * @brief Get a vector of functions used in the code but not listed as comments after any include directive.
+     * @brief Get the functions used in the code but not listed as comments after any include directive.
+     *
+     * @return Const reference to a table of unlisted functions, in line order.
+     */
+    [[nodiscard]] const UnlistedFunctionTable &get_unlisted_functions() const;
+
+    /**
+     * @brief Get a vector of standard include directives that provide none of the functions used in the code.
+     *
+     * @return Const reference to a vector of "RedundantInclude".
+     */
+    [[nodiscard]] const std::vector<RedundantInclude> &get_redundant_includes() const;
+
+    /**
+     * @brief Get a vector of functions listed after a standard include directive that does not provide them.
+     *
+     * @return Const reference to a vector of "MisattributedFunction".
+     */
+    [[nodiscard]] const std::vector<MisattributedFunction> &get_misattributed_functions() const;
+
+    /**
+     * @brief Get a vector of quoted include directives, i.e., project headers included with quotes instead of angle brackets.
+     *
+     * @return Const reference to a vector of included paths as written in the code, without quotes (e.g., {"core/io.hpp"}).
+     */
+    [[nodiscard]] const std::vector<std::string> &get_quoted_includes() const;
+
+    /**
+     * @brief Get a set of all functions listed as comments after any include directive.
+     *
+     * @return Const reference to a set of functions, all prefixed with "std::" (e.g., {"std::string", "std::vector"}).
+     */
+    [[nodiscard]] const std::unordered_set<std::string> &get_listed_functions() const;
+
+    /**
+     * @brief Get a set of all standard functions used in the code.
      *
-     * @return Const reference to a vector of "UnlistedFunction".
+     * @return Const reference to a set of functions, all prefixed with "std::" (e.g., {"std::sort"}).
      */
-    [[nodiscard]] const std::vector<UnlistedFunction> &get_unlisted_functions() const;
+    [[nodiscard]] const std::unordered_set<std::string> &get_used_functions() const;
+
+    /**
+     * @brief Get the text of a line that an unlisted function was found on.
+     *
+     * Only the lines with unlisted functions are kept after parsing, each of them once, regardless of the number of functions on it.
+     *
+     * @param number Original line number of an unlisted function (e.g., "31").
+     *
+     * @return Original line text (e.g., "std::sort(result.begin(), result.end());"), or an empty view if the line was not kept.
+     */
+    [[nodiscard]] std::string_view get_line(std::size_t number) const;
+
+    /**
+     * @brief Get every occurrence of a standard function, either used or listed.
+     *
+     * @return Const reference to a table of occurrences, in line order.
+     */
+    [[nodiscard]] const FunctionTable &get_occurrences() const;
+
+    /**
+     * @brief Treat the provided functions as listed, removing them from the unlisted functions.
+     *
+     * This is used when the functions are listed in another file, such as a header that is included by this file.
+     *
+     * @param functions Set of functions listed elsewhere, all prefixed with "std::" (e.g., {"std::vector"}).
+     */
+    void inherit_listed_functions(const std::unordered_set<std::string> &functions);
 
   private:
     /**
@@ -175,9 +589,44 @@ class CodeParser final {
     std::vector<IncludeWithUnusedFunctions> unused_functions_;
 
     /**
-     * @brief Vector of unlisted standard functions, i.e., functions used in the code but not listed as comments after an include directive.
+     * @brief Table of unlisted standard functions, i.e., functions used in the code but not listed as comments after an include directive.
+     */
+    UnlistedFunctionTable unlisted_functions_;
+
+    /**
+     * @brief Vector of redundant include directives, i.e., standard headers that provide none of the functions used in the code.
+     */
+    std::vector<RedundantInclude> redundant_includes_;
+
+    /**
+     * @brief Vector of misattributed functions, i.e., functions listed after a standard include directive that does not provide them.
+     */
+    std::vector<MisattributedFunction> misattributed_functions_;
+
+    /**
+     * @brief Vector of quoted include directives, without quotes (e.g., {"core/io.hpp"}).
+     */
+    std::vector<std::string> quoted_includes_;
+
+    /**
+     * @brief Set of functions listed as comments after include directives, prefixed with "std::".
+     */
+    std::unordered_set<std::string> listed_functions_;
+
+    /**
+     * @brief Set of standard functions used in the code, prefixed with "std::".
+     */
+    std::unordered_set<std::string> used_functions_;
+
+    /**
+     * @brief Table of every occurrence of a standard function, either used or listed, in line order.
+     */
+    FunctionTable occurrences_;
+
+    /**
+     * @brief Vector of the lines with unlisted functions, in line order, each line once.
      */
-    std::vector<UnlistedFunction> unlisted_functions_;
+    std::vector<core::io::Line> lines_;
 };
 
 }  // namespace modules::analyze
@@ -0,0 +1,398 @@
+/**
+ * @file fix.cpp
+ */
+
+#include <algorithm>      // for std::find, std::max
+#include <cctype>         // for std::isspace
+#include <cstddef>        // for std::size_t
+#include <filesystem>     // for std::filesystem
+#include <map>            // for std::map
+#include <optional>       // for std::optional, std::nullopt
+#include <sstream>        // for std::istringstream
+#include <string>         // for std::string, std::getline
+#include <string_view>    // for std::string_view
+#include <unordered_map>  // for std::unordered_map
+#include <unordered_set>  // for std::unordered_set
+#include <utility>        // for std::pair, std::move
+#include <vector>         // for std::vector
+
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include "core/diff.hpp"
+#include "core/io.hpp"
+#include "core/stdlib.hpp"
+#include "core/string.hpp"
+#include "core/symbols.hpp"
+#include "fix.hpp"
+#include "modules/analyze.hpp"
+
+namespace modules::fix {
+
+namespace {
+
+/**
+ * @brief Struct that represents the changes to a single include directive.
+ */
+struct Edit final {
+    /**
+     * @brief Functions to remove from the include comment, in lowercase (e.g., {"std::find"}).
+     */
+    std::unordered_set<std::string> remove;
+
+    /**
+     * @brief Functions to append to the include comment, in order of first use (e.g., {"std::sort"}).
+     */
+    std::vector<std::string> add;
+};
+
+/**
+ * @brief Private helper function to split code into lines, without the "\n" line endings.
+ *
+ * @param text Code to split (e.g., "a\nb\n").
+ *
+ * @return Vector of lines (e.g., {"a", "b"}). A trailing "\n" does not start a new line, like "std::getline".
+ */
+[[nodiscard]] std::vector<std::string> split_lines(const std::string &text)
+{
+    std::vector<std::string> lines;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t stop = text.find('\n', start);
+        if (stop == std::string::npos) {
+            stop = text.size();
+        }
+        lines.emplace_back(text.substr(start, stop - start));
+        start = stop + 1;
+    }
+    return lines;
+}
+
+/**
+ * @brief Private helper function to split the comment of an include directive into the names it lists.
+ *
+ * A comment is a list if, after an optional leading "for", it consists of names separated by commas (e.g., " for std::find, std::sort"). An empty comment is an empty list.
+ *
+ * @param comment Comment without the "//" (e.g., " for std::find, std::sort").
+ *
+ * @return Names in the order they are listed (e.g., {"std::find", "std::sort"}), or std::nullopt if the comment is prose (e.g., " std::vector is needed here").
+ */
+[[nodiscard]] std::optional<std::vector<std::string>> split_comment(const std::string &comment)
+{
+    std::string list = core::string::strip_whitespace(comment);
+    if (const std::string lower_list = core::string::to_lower(list);
+        lower_list.compare(0, 3, "for") == 0 && (list.size() == 3 || std::isspace(static_cast<unsigned char>(list[3])) != 0)) {
+        list = core::string::strip_whitespace(list.substr(3));
+    }
+
+    std::vector<std::string> names;
+    std::istringstream iss(list);
+    for (std::string item; std::getline(iss, item, ',');) {
+        const std::string name = core::string::strip_whitespace(item);
+        if (name.find_first_of(" \t") != std::string::npos) {
+            return std::nullopt;
+        }
+        if (!name.empty()) {
+            names.emplace_back(name);
+        }
+    }
+    return names;
+}
+
+/**
+ * @brief Private helper function to rewrite the comment of an include directive.
+ *
+ * If the comment lists names, the remaining names are written back as "// for a, b". A comment that does not list names (e.g., "// std::vector is needed here") is left verbatim, even if it mentions functions to remove or the include directive should list more functions.
+ *
+ * @param line Include directive without the line ending (e.g., "#include <algorithm>  // for std::find, std::sort").
+ * @param edit Changes to apply.
+ * @param column Column at which a new comment is aligned (e.g., "22"), or 0 to separate it from the directive by two spaces.
+ *
+ * @return Rewritten include directive (e.g., "#include <algorithm>  // for std::sort").
+ */
+[[nodiscard]] std::string rewrite_include(std::string line,
+                                          const Edit &edit,
+                                          const std::size_t column)
+{
+    // Keep a carriage return of a CRLF line ending at the end of the line
+    std::string carriage_return;
+    if (!line.empty() && line.back() == '\r') {
+        carriage_return = "\r";
+        line.pop_back();
+    }
+
+    // Split the line into the directive and the names in its comment, leaving prose comments untouched
+    const std::size_t comment_start = line.find("//");
+    std::string directive = line.substr(0, comment_start);
+    std::vector<std::string> names;
+    std::unordered_set<std::string> seen;
+    if (comment_start != std::string::npos) {
+        const auto listed_names = split_comment(line.substr(comment_start + 2));
+        if (!listed_names) {
+            return line + carriage_return;
+        }
+        for (const auto &name : *listed_names) {
+            const std::string lower_name = core::string::to_lower(name);
+            if (edit.remove.find(lower_name) == edit.remove.cend() && seen.insert(lower_name).second) {
+                names.emplace_back(name);
+            }
+        }
+    }
+    for (const auto &function : edit.add) {
+        if (seen.insert(function).second) {
+            names.emplace_back(function);
+        }
+    }
+
+    // Drop the comment if no names are left, otherwise keep the original spacing before it
+    if (names.empty() || comment_start == std::string::npos) {
+        directive.erase(directive.find_last_not_of(" \t") + 1);
+    }
+    if (names.empty()) {
+        return directive + carriage_return;
+    }
+    if (comment_start == std::string::npos) {
+        directive.resize(std::max(column, directive.size() + 2), ' ');
+    }
+    return fmt::format("{}// for {}{}", directive, fmt::join(names, ", "), carriage_return);
+}
+
+/**
+ * @brief Private helper function to find the block of standard include directives, i.e., the first run of consecutive lines that include headers without a file extension.
+ *
+ * @param includes Include directives as (0-based line index, lowercase header) pairs in line order.
+ *
+ * @return Half-open range of indices into "includes" (e.g., {0, 5}). Empty if there are no standard include directives.
+ */
+[[nodiscard]] std::pair<std::size_t, std::size_t> find_standard_block(const std::vector<std::pair<std::size_t, std::string>> &includes)
+{
+    const auto is_standard = [](const std::string &header) { return header.find('.') == std::string::npos; };
+    std::size_t first = 0;
+    while (first < includes.size() && !is_standard(includes[first].second)) {
+        ++first;
+    }
+    std::size_t last = first;
+    while (last < includes.size() && is_standard(includes[last].second) &&
+           (last == first || includes[last].first == includes[last - 1].first + 1)) {
+        ++last;
+    }
+    return {first, last};
+}
+
+/**
+ * @brief Private helper function to find the column at which the comments of a block of include directives are aligned.
+ *
+ * @param lines Lines of the code.
+ * @param includes Include directives as (0-based line index, lowercase header) pairs in line order.
+ * @param first First index of the block into "includes".
+ * @param last Past-the-end index of the block into "includes".
+ *
+ * @return Column of the "//" shared by all comments in the block (e.g., "26"), or 0 if the comments are not aligned.
+ */
+[[nodiscard]] std::size_t find_comment_column(const std::vector<std::string> &lines,
+                                              const std::vector<std::pair<std::size_t, std::string>> &includes,
+                                              const std::size_t first,
+                                              const std::size_t last)
+{
+    std::size_t column = 0;
+    for (std::size_t i = first; i < last; ++i) {
+        const std::size_t comment_start = lines[includes[i].first].find("//");
+        if (comment_start == std::string::npos) {
+            continue;
+        }
+        if (column != 0 && column != comment_start) {
+            return 0;
+        }
+        column = comment_start;
+    }
+    return column;
+}
+
+/**
+ * @brief Private helper function to find where a new block of include directives shall be inserted, if the code has no standard include directives.
+ *
+ * @param lines Lines of the code.
+ * @param includes Include directives as (0-based line index, lowercase header) pairs in line order.
+ *
+ * @return 0-based index of the line before which the block is inserted: the first include directive, otherwise the line after "#pragma once", otherwise the first line.
+ */
+[[nodiscard]] std::size_t find_block_position(const std::vector<std::string> &lines,
+                                              const std::vector<std::pair<std::size_t, std::string>> &includes)
+{
+    if (!includes.empty()) {
+        return includes.front().first;
+    }
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        if (core::string::to_lower(core::string::strip_whitespace(lines[i])).compare(0, 12, "#pragma once") == 0) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+std::string fix_text(const std::string &text,
+                     const analyze::CodeParser &parser,
+                     const Options &options)
+{
+    std::vector<std::string> lines = split_lines(text);
+
+    // Collect the changes per line, keyed by 1-based line number, so that each line is rewritten once
+    std::map<std::size_t, Edit> edits;
+
+    if (options.remove_unused) {
+        for (const auto &entry : parser.get_unused_functions()) {
+            edits[entry.number].remove.insert(entry.unused_functions.cbegin(), entry.unused_functions.cend());
+        }
+    }
+
+    // Missing include directives to insert, keyed by header, so that they are inserted in sorted order (e.g., "algorithm" -> {"std::sort"})
+    std::map<std::string, std::vector<std::string>> missing_includes;
+
+    // Include directives with angle brackets, as (0-based line index, lowercase header) pairs in line order
+    std::vector<std::pair<std::size_t, std::string>> includes;
+
+    if (options.add_unlisted && !parser.get_unlisted_functions().empty()) {
+        // Find the first line of each included header, e.g., "vector" -> 3
+        std::unordered_map<std::string, std::size_t> header_lines;
+        for (std::size_t i = 0; i < lines.size(); ++i) {
+            // Match the lines like the parser does, so that the line numbers of its results refer to the same include directives
+            const std::string processed_line = core::string::to_lower(core::string::strip_whitespace(lines[i]));
+            if (const std::string_view include_directive = analyze::find_include_directive(processed_line); !include_directive.empty()) {
+                const std::string header(analyze::get_include_header(include_directive));
+                header_lines.try_emplace(header, i + 1);
+                includes.emplace_back(i, header);
+            }
+        }
+
+        // Append each unlisted function once, to the first included header that provides it, preferring the primary header
+        // If no providing header is included, remember the primary header, so that its include directive can be inserted
+        std::unordered_set<core::symbols::Id> handled;
+        for (const auto id : parser.get_unlisted_functions().get_functions()) {
+            if (!handled.insert(id).second) {
+                continue;
+            }
+            const std::string_view function = core::symbols::get_name(id);
+            bool appended = false;
+            for (const auto header : core::stdlib::find_headers(function)) {
+                if (const auto it = header_lines.find(std::string(header)); it != header_lines.cend()) {
+                    auto &add = edits[it->second].add;
+                    if (std::find(add.cbegin(), add.cend(), function) == add.cend()) {
+                        add.emplace_back(function);
+                    }
+                    appended = true;
+                    break;
+                }
+            }
+            if (!appended && options.insert_includes) {
+                if (const auto header = core::stdlib::find_primary_header(function)) {
+                    missing_includes[std::string(*header)].emplace_back(function);
+                }
+            }
+        }
+    }
+
+    // Nothing to fix, return the original code unchanged
+    if (edits.empty() && missing_includes.empty()) {
+        return text;
+    }
+
+    // Find the block of standard includes and the column of its comments before any line is rewritten, so that new comments are aligned with the original ones
+    const auto [first, last] = find_standard_block(includes);
+    const std::size_t column = find_comment_column(lines, includes, first, last);
+    const auto is_in_block = [&includes, first = first, last = last](const std::size_t index) {
+        return first < last && index >= includes[first].first && index <= includes[last - 1].first;
+    };
+
+    // Rewrite the affected lines, skipping line numbers that are out of range (e.g., the file changed since it was parsed)
+    for (const auto &[number, edit] : edits) {
+        if (number >= 1 && number <= lines.size()) {
+            lines[number - 1] = rewrite_include(lines[number - 1], edit, is_in_block(number - 1) ? column : 0);
+        }
+    }
+
+    // Insert all missing include directives at once, keyed by the index of the line they are inserted before
+    std::map<std::size_t, std::vector<std::string>> insertions;
+    if (!missing_includes.empty()) {
+        const std::string line_ending = !lines.empty() && !lines.front().empty() && lines.front().back() == '\r' ? "\r" : "";
+        const std::size_t block_position = find_block_position(lines, includes);
+
+        // Without a block of standard includes, start a new block, separated from the preceding line by an empty line
+        if (first == last && block_position > 0 && !core::string::strip_whitespace(lines[block_position - 1]).empty()) {
+            insertions[block_position].emplace_back(line_ending);
+        }
+
+        for (const auto &[header, functions] : missing_includes) {
+            // Align the comment with the comments of the block if they are aligned
+            std::string directive = fmt::format("#include <{}>", header);
+            directive.resize(std::max(column, directive.size() + 2), ' ');
+
+            // Insert before the first include of the block that sorts after the header, or after the block
+            std::size_t position = block_position;
+            if (first < last) {
+                position = includes[last - 1].first + 1;
+                for (std::size_t i = first; i < last; ++i) {
+                    if (includes[i].second > header) {
+                        position = includes[i].first;
+                        break;
+                    }
+                }
+            }
+            insertions[position].emplace_back(fmt::format("{}// for {}{}", directive, fmt::join(functions, ", "), line_ending));
+        }
+
+        // Separate a new block from the line that follows it by an empty line
+        if (first == last && block_position < lines.size() && !core::string::strip_whitespace(lines[block_position]).empty()) {
+            insertions[block_position].emplace_back(line_ending);
+        }
+    }
+
+    // Join the lines and the inserted lines, keeping the final line ending if the original code had one
+    std::vector<std::string> output;
+    output.reserve(lines.size() + missing_includes.size() + 2);
+    for (std::size_t i = 0; i <= lines.size(); ++i) {
+        if (const auto it = insertions.find(i); it != insertions.cend()) {
+            output.insert(output.cend(), it->second.cbegin(), it->second.cend());
+        }
+        if (i < lines.size()) {
+            output.emplace_back(std::move(lines[i]));
+        }
+    }
+    std::string fixed = fmt::format("{}", fmt::join(output, "\n"));
+    if (!text.empty() && text.back() == '\n') {
+        fixed += '\n';
+    }
+    return fixed;
+}
+
+bool fix_file(const std::filesystem::path &path,
+              const analyze::CodeParser &parser,
+              const Options &options)
+{
+    const std::string text = core::io::read_text(path);
+    const std::string fixed = fix_text(text, parser, options);
+    if (fixed == text) {
+        return false;
+    }
+    core::io::write_text_atomically(path, fixed);
+    return true;
+}
+
+std::string diff_file(const std::filesystem::path &path,
+                      const analyze::CodeParser &parser,
+                      const Options &options)
+{
+    const std::string text = core::io::read_text(path);
+    const std::string fixed = fix_text(text, parser, options);
+    if (fixed == text) {
+        return {};
+    }
+
+    // Use forward slashes on all platforms, since patches do not support backslashes
+    const std::filesystem::path relative_path = path.lexically_relative(std::filesystem::current_path());
+    const std::string label = relative_path.empty() ? path.generic_string() : relative_path.generic_string();
+    return core::diff::unified_diff(text, fixed, label);
+}
+
+}  // namespace modules::fix
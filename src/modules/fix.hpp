@@ -0,0 +1,89 @@
+/**
+ * @file fix.hpp
+ *
+ * @brief Rewrite the include comments of C++ code to fix the findings of the analysis.
+ */
+
+#pragma once
+
+#include <filesystem>  // for std::filesystem
+#include <string>      // for std::string
+
+#include "modules/analyze.hpp"
+
+namespace modules::fix {
+
+/**
+ * @brief Struct that represents which kinds of findings shall be fixed.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Options final {
+    /**
+     * @brief If true, remove unused functions from the include comments.
+     */
+    bool remove_unused;
+
+    /**
+     * @brief If true, append unlisted functions to the include comment of a header that provides them.
+     */
+    bool add_unlisted;
+
+    /**
+     * @brief If true, insert an include directive for unlisted functions whose header is not included at all (e.g., "#include <algorithm>  // for std::sort").
+     */
+    bool insert_includes;
+};
+
+/**
+ * @brief Compute the fixed version of C++ code.
+ *
+ * Unused functions are removed from their include comment, and the comment is dropped if no names are left. Unlisted functions are appended to the comment of the first included header that provides them, according to the compiled symbol-to-header table. Unlisted functions whose header is not included are grouped by their preferred header, and a single include directive per header is inserted into the block of standard include directives at its sorted position, if enabled. Unknown functions are left alone.
+ *
+ * Only include directives that need to change are rewritten or inserted, all other lines, including line endings, are kept byte for byte.
+ *
+ * @param text Original code, exactly as it was parsed (e.g., "#include <vector>  // for std::vector, std::sort\n").
+ * @param parser Parsed code.
+ * @param options Kinds of findings to fix.
+ *
+ * @return Fixed code (e.g., "#include <vector>  // for std::vector\n"). Identical to the original code if there is nothing to fix.
+ */
+[[nodiscard]] std::string fix_text(const std::string &text,
+                                   const analyze::CodeParser &parser,
+                                   const Options &options);
+
+/**
+ * @brief Fix a C++ file on disk.
+ *
+ * The file is only rewritten if the fixed code differs from the original code. The rewrite is atomic, so that a crash never leaves a partially written file.
+ *
+ * @param path Path to the C++ file that was parsed (e.g., "~/main.cpp").
+ * @param parser Parsed file.
+ * @param options Kinds of findings to fix.
+ *
+ * @return True if the file was rewritten, false if there was nothing to fix.
+ *
+ * @throws std::runtime_error If the file cannot be read or written.
+ */
+bool fix_file(const std::filesystem::path &path,
+              const analyze::CodeParser &parser,
+              const Options &options);
+
+/**
+ * @brief Render the changes that "fix_file" would make to a C++ file as a unified diff, without modifying the file.
+ *
+ * The paths in the diff are relative to the current working directory, so that the output can be applied with "git apply" from there.
+ *
+ * @param path Path to the C++ file that was parsed (e.g., "~/src/main.cpp").
+ * @param parser Parsed file.
+ * @param options Kinds of findings to fix.
+ *
+ * @return Unified diff (e.g., "--- a/src/main.cpp\n+++ b/src/main.cpp\n@@ -1,3 +1,3 @@\n..."), or an empty string if there is nothing to fix.
+ *
+ * @throws std::runtime_error If the file cannot be read.
+ */
+[[nodiscard]] std::string diff_file(const std::filesystem::path &path,
+                                    const analyze::CodeParser &parser,
+                                    const Options &options);
+
+}  // namespace modules::fix
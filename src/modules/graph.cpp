@@ -0,0 +1,245 @@
+/**
+ * @file graph.cpp
+ */
+
+#include <algorithm>      // for std::find
+#include <array>          // for std::array
+#include <cstddef>        // for std::size_t
+#include <exception>      // for std::current_exception
+#include <filesystem>     // for std::filesystem
+#include <future>         // for std::promise, std::shared_future
+#include <memory>         // for std::shared_ptr, std::make_shared
+#include <mutex>          // for std::mutex, std::lock_guard
+#include <optional>       // for std::optional, std::nullopt
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <system_error>   // for std::error_code
+#include <unordered_set>  // for std::unordered_set
+#include <utility>        // for std::move
+#include <vector>         // for std::vector
+
+#include "graph.hpp"
+#include "modules/analyze.hpp"
+
+namespace modules::graph {
+
+namespace {
+
+/**
+ * @brief Private helper function to convert a path into the key used by the include graph.
+ *
+ * @param path Path to convert (e.g., "~/src/../src/app.cpp").
+ *
+ * @return Absolute, normalized path (e.g., "~/src/app.cpp").
+ */
+[[nodiscard]] std::filesystem::path normalize(const std::filesystem::path &path)
+{
+    return std::filesystem::absolute(path).lexically_normal();
+}
+
+/**
+ * @brief Private helper function to resolve all quoted includes of a parsed file.
+ *
+ * @param parser Parsed file.
+ * @param path Path to the parsed file (e.g., "~/src/app.cpp").
+ * @param include_directories Directories to search for quoted includes (e.g., {"~/src"}).
+ *
+ * @return Vector of resolved includes, unresolved includes are skipped (e.g., {"~/src/app.hpp"}).
+ */
+[[nodiscard]] std::vector<std::filesystem::path> resolve_includes(const analyze::CodeParser &parser,
+                                                                  const std::filesystem::path &path,
+                                                                  const std::vector<std::filesystem::path> &include_directories)
+{
+    std::vector<std::filesystem::path> resolved;
+    resolved.reserve(parser.get_quoted_includes().size());
+    for (const auto &include : parser.get_quoted_includes()) {
+        if (auto header = resolve_include(include, path, include_directories)) {
+            resolved.emplace_back(std::move(*header));
+        }
+    }
+    return resolved;
+}
+
+}  // namespace
+
+std::optional<std::filesystem::path> resolve_include(const std::string &include,
+                                                     const std::filesystem::path &including_file,
+                                                     const std::vector<std::filesystem::path> &include_directories)
+{
+    // Use the non-throwing overload, a missing or unreadable candidate is not an error
+    std::error_code ec;
+
+    // Search the directory of the including file first
+    if (const auto candidate = including_file.parent_path() / include; std::filesystem::is_regular_file(candidate, ec)) {
+        return normalize(candidate);
+    }
+
+    // Then search the include directories in order
+    for (const auto &directory : include_directories) {
+        if (const auto candidate = directory / include; std::filesystem::is_regular_file(candidate, ec)) {
+            return normalize(candidate);
+        }
+    }
+
+    // Not a project header (e.g., a third-party header included with quotes)
+    return std::nullopt;
+}
+
+bool is_source_file(const std::filesystem::path &path)
+{
+    static const std::array<std::string_view, 3> source_extensions = {".cpp", ".cxx", ".cc"};
+    const std::string extension = path.extension().string();
+    return std::find(source_extensions.cbegin(), source_extensions.cend(), extension) != source_extensions.cend();
+}
+
+std::optional<std::filesystem::path> find_paired_header(const std::filesystem::path &source)
+{
+    // Only source files have a paired header, a header is never paired with another header
+    static const std::array<std::string_view, 4> header_extensions = {".hpp", ".h", ".hh", ".hxx"};
+    if (!is_source_file(source)) {
+        return std::nullopt;
+    }
+
+    // Use the non-throwing overload, a missing or unreadable candidate is not an error
+    std::error_code ec;
+    for (const auto &header_extension : header_extensions) {
+        if (auto candidate = std::filesystem::path(source).replace_extension(header_extension); std::filesystem::is_regular_file(candidate, ec)) {
+            return normalize(candidate);
+        }
+    }
+    return std::nullopt;
+}
+
+Summary::Summary(const std::filesystem::path &path,
+                 const analyze::CodeParser &parser,
+                 const std::vector<std::filesystem::path> &include_directories)
+    : listed_functions(parser.get_listed_functions()),
+      includes(resolve_includes(parser, path, include_directories)) {}
+
+IncludeGraph::IncludeGraph(const std::vector<std::filesystem::path> &include_directories,
+                           const bool keep_parsers)
+    : include_directories_(include_directories),
+      keep_parsers_(keep_parsers) {}
+
+std::shared_ptr<const Summary> IncludeGraph::get_summary(const std::filesystem::path &path)
+{
+    return this->find_or_create_summary(path, nullptr);
+}
+
+std::shared_ptr<const Summary> IncludeGraph::get_summary(const std::filesystem::path &path,
+                                                         const analyze::CodeParser &parser)
+{
+    return this->find_or_create_summary(path, &parser);
+}
+
+std::shared_ptr<const Summary> IncludeGraph::find_or_create_summary(const std::filesystem::path &path,
+                                                                    const analyze::CodeParser *parser)
+{
+    const std::filesystem::path normalized_path = normalize(path);
+    const std::string key = normalized_path.string();
+
+    // Either find the existing future, or register a new one that this thread must fulfill
+    std::promise<std::shared_ptr<const Summary>> promise;
+    std::shared_future<std::shared_ptr<const Summary>> future;
+    bool is_owner = false;
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex_);
+        const auto [it, inserted] = this->summaries_.try_emplace(key);
+        if (inserted) {
+            it->second = promise.get_future().share();
+            is_owner = true;
+        }
+        future = it->second;
+    }
+
+    // Another thread owns the file, wait for its result outside of the lock
+    if (!is_owner) {
+        return future.get();
+    }
+
+    // Parse the file outside of the lock, so that other files can be parsed at the same time, unless the caller already parsed it
+    // Parsing a file never waits for another summary, so cyclic includes cannot deadlock
+    // The parser is only needed to create the summary, so it is destroyed right after, unless it is kept to be taken over later
+    try {
+        std::shared_ptr<const Summary> summary;
+        if (parser != nullptr) {
+            summary = std::make_shared<const Summary>(normalized_path, *parser, this->include_directories_);
+        }
+        else {
+            analyze::CodeParser parsed(normalized_path);
+            summary = std::make_shared<const Summary>(normalized_path, parsed, this->include_directories_);
+            if (this->keep_parsers_) {
+                const std::lock_guard<std::mutex> lock(this->mutex_);
+                this->parsers_.try_emplace(key, std::move(parsed));
+            }
+        }
+        promise.set_value(summary);
+        return summary;
+    }
+    catch (...) {
+        // Propagate the error to every thread waiting for this file, then rethrow
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+std::vector<std::filesystem::path> IncludeGraph::get_reachable_headers(const std::filesystem::path &path,
+                                                                       const analyze::CodeParser &parser)
+{
+    const std::filesystem::path normalized_path = normalize(path);
+
+    // Breadth-first traversal of the include graph, starting at the includes of the file itself, which is not memoised
+    std::unordered_set<std::string> visited = {normalized_path.string()};
+    std::vector<std::filesystem::path> reachable;
+    const auto visit = [&visited, &reachable](const std::vector<std::filesystem::path> &includes) {
+        for (const auto &header : includes) {
+            // Skip headers that were already visited (e.g., diamond or cyclic includes)
+            if (visited.insert(header.string()).second) {
+                reachable.emplace_back(header);
+            }
+        }
+    };
+    visit(resolve_includes(parser, normalized_path, this->include_directories_));
+    for (std::size_t i = 0; i < reachable.size(); ++i) {
+        visit(this->get_summary(reachable[i])->includes);
+    }
+
+    return reachable;
+}
+
+std::unordered_set<std::string> IncludeGraph::get_inherited_functions(const std::filesystem::path &path,
+                                                                      const analyze::CodeParser &parser)
+{
+    return this->get_listed_functions(this->get_reachable_headers(path, parser));
+}
+
+std::unordered_set<std::string> IncludeGraph::get_listed_functions(const std::vector<std::filesystem::path> &headers)
+{
+    std::unordered_set<std::string> listed;
+    for (const auto &header : headers) {
+        const auto &listed_functions = this->get_summary(header)->listed_functions;
+        listed.insert(listed_functions.cbegin(), listed_functions.cend());
+    }
+    return listed;
+}
+
+std::optional<analyze::CodeParser> IncludeGraph::take_parser(const std::filesystem::path &path)
+{
+    const std::string key = normalize(path).string();
+    const std::lock_guard<std::mutex> lock(this->mutex_);
+    const auto it = this->parsers_.find(key);
+    if (it == this->parsers_.end()) {
+        return std::nullopt;
+    }
+    std::optional<analyze::CodeParser> parser(std::move(it->second));
+    this->parsers_.erase(it);
+    return parser;
+}
+
+std::size_t IncludeGraph::get_parsed_count() const
+{
+    const std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->summaries_.size();
+}
+
+}  // namespace modules::graph
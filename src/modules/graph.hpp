@@ -0,0 +1,226 @@
+/**
+ * @file graph.hpp
+ *
+ * @brief Resolve quoted include directives and paired headers, and share the listed functions of project headers.
+ */
+
+#pragma once
+
+#include <cstddef>        // for std::size_t
+#include <filesystem>     // for std::filesystem
+#include <future>         // for std::shared_future
+#include <memory>         // for std::shared_ptr
+#include <mutex>          // for std::mutex
+#include <optional>       // for std::optional
+#include <string>         // for std::string
+#include <unordered_map>  // for std::unordered_map
+#include <unordered_set>  // for std::unordered_set
+#include <vector>         // for std::vector
+
+#include "modules/analyze.hpp"
+
+namespace modules::graph {
+
+/**
+ * @brief Resolve a quoted include directive to a file on disk.
+ *
+ * The directory of the including file is searched first, then the include directories in order, like a compiler does for quoted includes.
+ *
+ * @param include Included path as written in the code, without quotes (e.g., "core/io.hpp").
+ * @param including_file Path to the file that contains the include directive (e.g., "~/src/app.cpp").
+ * @param include_directories Directories to search after the including file's directory (e.g., {"~/src"}).
+ *
+ * @return Absolute, normalized path to the included file (e.g., "~/src/core/io.hpp"), or std::nullopt if it could not be found (e.g., a system header).
+ */
+[[nodiscard]] std::optional<std::filesystem::path> resolve_include(const std::string &include,
+                                                                   const std::filesystem::path &including_file,
+                                                                   const std::vector<std::filesystem::path> &include_directories);
+
+/**
+ * @brief Find the header paired with a source file by convention, i.e., a header with the same name in the same directory.
+ *
+ * The header extensions are tried in order: ".hpp", ".h", ".hh", ".hxx".
+ *
+ * @param source Path to the source file (e.g., "~/src/modules/analyze.cpp").
+ *
+ * @return Path to the paired header (e.g., "~/src/modules/analyze.hpp"), or std::nullopt if the file is not a source file or has no paired header.
+ */
+[[nodiscard]] std::optional<std::filesystem::path> find_paired_header(const std::filesystem::path &source);
+
+/**
+ * @brief Check if a file is a source file, i.e., a translation unit rather than a header, by its extension.
+ *
+ * @param path Path to the file (e.g., "~/src/app.cpp").
+ *
+ * @return True if the extension is ".cpp", ".cxx" or ".cc", false otherwise.
+ */
+[[nodiscard]] bool is_source_file(const std::filesystem::path &path);
+
+/**
+ * @brief Struct that represents a parsed file in the include graph.
+ *
+ * Only the parts needed by the files that include it are kept, not the whole parser, so that a summary stays small and is never copied.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Summary final {
+    /**
+     * @brief Construct a new Summary object.
+     *
+     * @param path Path to the parsed file (e.g., "~/src/core/io.hpp").
+     * @param parser Parsed file.
+     * @param include_directories Directories to search for quoted includes (e.g., {"~/src"}).
+     */
+    explicit Summary(const std::filesystem::path &path,
+                     const analyze::CodeParser &parser,
+                     const std::vector<std::filesystem::path> &include_directories);
+
+    /**
+     * @brief Set of functions listed as comments after include directives, all prefixed with "std::" (e.g., {"std::vector"}).
+     */
+    const std::unordered_set<std::string> listed_functions;
+
+    /**
+     * @brief Resolved quoted includes of the file (e.g., {"~/src/core/io.hpp"}). Includes that could not be resolved are skipped.
+     */
+    const std::vector<std::filesystem::path> includes;
+};
+
+/**
+ * @brief Class that represents the graph of quoted include directives between project files.
+ *
+ * Each included file is parsed at most once per instance, no matter how many files include it or how many threads ask for it at the same time. The summaries of the included files are kept until the instance is destroyed, but the files whose includes are followed are not kept themselves, so that the memory grows with the number of headers rather than the number of translation units. All public member functions are thread-safe.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class IncludeGraph final {
+  public:
+    /**
+     * @brief Construct a new IncludeGraph object.
+     *
+     * @param include_directories Directories to search for quoted includes (e.g., {"~/src"}).
+     * @param keep_parsers If true, the parsers of the files that the graph parses itself are kept until they are taken with "take_parser", so that files which are analyzed later are not parsed again (e.g., the discovered headers).
+     */
+    explicit IncludeGraph(const std::vector<std::filesystem::path> &include_directories,
+                          const bool keep_parsers = false);
+
+    /**
+     * @brief Get the summary of a file, parsing it on first use.
+     *
+     * If another thread is already parsing the same file, this function waits for it instead of parsing the file again.
+     *
+     * @param path Path to the file (e.g., "~/src/core/io.hpp").
+     *
+     * @return Shared pointer to the memoised summary.
+     *
+     * @throws std::runtime_error If the file cannot be read.
+     */
+    [[nodiscard]] std::shared_ptr<const Summary> get_summary(const std::filesystem::path &path);
+
+    /**
+     * @brief Get the summary of a file that was already parsed by the caller, creating it from the parser on first use.
+     *
+     * This lets the files that are analyzed anyway share their summary, instead of being parsed a second time when another file includes them.
+     *
+     * @param path Path to the file (e.g., "~/src/core/io.hpp").
+     * @param parser Parsed file, only read if the summary does not exist yet.
+     *
+     * @return Shared pointer to the memoised summary.
+     */
+    [[nodiscard]] std::shared_ptr<const Summary> get_summary(const std::filesystem::path &path,
+                                                             const analyze::CodeParser &parser);
+
+    /**
+     * @brief Get all project headers that are transitively included by a file that was already parsed by the caller.
+     *
+     * The traversal starts at the quoted includes of the parser, so the file itself is not memoised, only the headers it reaches.
+     *
+     * @param path Path to the file (e.g., "~/src/app.cpp").
+     * @param parser Parsed file.
+     *
+     * @return Vector of absolute, normalized paths in breadth-first order, excluding the file itself (e.g., {"~/src/app.hpp", "~/src/core/args.hpp"}).
+     */
+    [[nodiscard]] std::vector<std::filesystem::path> get_reachable_headers(const std::filesystem::path &path,
+                                                                           const analyze::CodeParser &parser);
+
+    /**
+     * @brief Get all functions listed in the project headers that are transitively included by a file that was already parsed by the caller.
+     *
+     * The functions listed in the file itself are not part of the result.
+     *
+     * @param path Path to the file (e.g., "~/src/app.cpp").
+     * @param parser Parsed file.
+     *
+     * @return Set of inherited functions, all prefixed with "std::" (e.g., {"std::vector"}).
+     */
+    [[nodiscard]] std::unordered_set<std::string> get_inherited_functions(const std::filesystem::path &path,
+                                                                          const analyze::CodeParser &parser);
+
+    /**
+     * @brief Get all functions listed in the provided project headers.
+     *
+     * @param headers Paths to the headers, e.g., as returned by "get_reachable_headers" (e.g., {"~/src/app.hpp"}).
+     *
+     * @return Set of listed functions, all prefixed with "std::" (e.g., {"std::vector"}).
+     */
+    [[nodiscard]] std::unordered_set<std::string> get_listed_functions(const std::vector<std::filesystem::path> &headers);
+
+    /**
+     * @brief Take over the parser of a file that the graph parsed itself, if it was kept.
+     *
+     * Each kept parser is handed out once, then it is released by the graph.
+     *
+     * @param path Path to the file (e.g., "~/src/core/io.hpp").
+     *
+     * @return Parser of the file, or std::nullopt if the graph did not parse the file itself, the parsers are not kept, or the parser was already taken.
+     */
+    [[nodiscard]] std::optional<analyze::CodeParser> take_parser(const std::filesystem::path &path);
+
+    /**
+     * @brief Get the number of files parsed so far.
+     *
+     * @return Number of memoised summaries (e.g., "12").
+     */
+    [[nodiscard]] std::size_t get_parsed_count() const;
+
+  private:
+    /**
+     * @brief Private helper function to get the summary of a file, creating it on first use.
+     *
+     * @param path Path to the file (e.g., "~/src/core/io.hpp").
+     * @param parser Parsed file to create the summary from, or nullptr to parse the file.
+     *
+     * @return Shared pointer to the memoised summary.
+     *
+     * @throws std::runtime_error If the file has to be parsed and cannot be read.
+     */
+    [[nodiscard]] std::shared_ptr<const Summary> find_or_create_summary(const std::filesystem::path &path,
+                                                                        const analyze::CodeParser *parser);
+
+    /**
+     * @brief Directories to search for quoted includes.
+     */
+    const std::vector<std::filesystem::path> include_directories_;
+
+    /**
+     * @brief If true, the parsers of the files that the graph parses itself are kept until they are taken.
+     */
+    const bool keep_parsers_;
+
+    /**
+     * @brief Mutex that protects the summaries and parsers maps. It is never held while a file is being parsed.
+     */
+    mutable std::mutex mutex_;
+
+    /**
+     * @brief Memoised summaries, keyed by absolute, normalized path. A future is stored, so that concurrent requests for the same file wait for the first one.
+     */
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const Summary>>> summaries_;
+
+    /**
+     * @brief Kept parsers that were not taken yet, keyed by absolute, normalized path. Empty unless "keep_parsers_" is true.
+     */
+    std::unordered_map<std::string, analyze::CodeParser> parsers_;
+};
+
+}  // namespace modules::graph
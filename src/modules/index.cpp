@@ -0,0 +1,313 @@
+/**
+ * @file index.cpp
+ */
+
+#include <algorithm>    // for std::sort
+#include <array>        // for std::array
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <cstdint>      // for std::uint32_t, std::uint64_t
+#include <cstring>      // for std::memcpy
+#include <exception>    // for std::exception
+#include <filesystem>   // for std::filesystem
+#include <mutex>        // for std::mutex, std::lock_guard
+#include <stdexcept>    // for std::runtime_error
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <tuple>        // for std::tie
+#include <utility>      // for std::pair
+#include <vector>       // for std::vector
+
+#include <fmt/core.h>
+
+#include "core/io.hpp"
+#include "core/mmap.hpp"
+#include "core/symbols.hpp"
+#include "index.hpp"
+#include "modules/analyze.hpp"
+
+namespace modules::index {
+
+namespace {
+
+/**
+ * @brief Magic bytes at the start of every index file, including the format version.
+ */
+constexpr std::array<char, 8> index_magic = {'H', 'W', 'I', 'D', 'X', '0', '0', '1'};
+
+/**
+ * @brief On-disk header, followed by the file table, the function table, the postings, and the string blob.
+ */
+struct HeaderRecord final {
+    std::array<char, 8> magic;
+    std::uint64_t file_count;
+    std::uint64_t function_count;
+    std::uint64_t posting_count;
+    std::uint64_t strings_size;
+};
+
+/**
+ * @brief On-disk reference to a string in the string blob.
+ */
+struct StringRecord final {
+    std::uint64_t offset;
+    std::uint64_t length;
+};
+
+/**
+ * @brief On-disk function entry, sorted by name so that it can be binary-searched.
+ */
+struct FunctionRecord final {
+    StringRecord name;
+    std::uint64_t first_posting;
+    std::uint64_t posting_count;
+};
+
+/**
+ * @brief On-disk occurrence of a function, sorted by file and line within each function.
+ */
+struct PostingRecord final {
+    std::uint32_t file;
+    std::uint32_t number;
+    std::uint32_t kind;
+};
+
+/**
+ * @brief Private helper function to read a record from the mapped index without violating alignment or aliasing rules.
+ *
+ * @param data Pointer to the mapped index.
+ * @param offset Byte offset of the record.
+ *
+ * @return Copy of the record.
+ */
+template <typename Record>
+[[nodiscard]] Record load(const char *data,
+                          const std::size_t offset)
+{
+    Record record;
+    std::memcpy(&record, data + offset, sizeof(Record));
+    return record;
+}
+
+/**
+ * @brief Private helper function to append a record to the bytes of an index.
+ *
+ * @param bytes Bytes of the index written so far.
+ * @param record Record to append.
+ */
+template <typename Record>
+void store(std::string &bytes,
+           const Record &record)
+{
+    bytes.append(reinterpret_cast<const char *>(&record), sizeof(Record));
+}
+
+/**
+ * @brief Private helper function to map an index file, reporting errors like the other index errors.
+ *
+ * @param input_path Path to the index file (e.g., "~/header-warden.idx").
+ *
+ * @return Mapped index file.
+ *
+ * @throws std::runtime_error If the file does not exist or cannot be mapped.
+ */
+[[nodiscard]] core::mmap::MappedFile map_index(const std::filesystem::path &input_path)
+{
+    try {
+        return core::mmap::MappedFile(input_path);
+    }
+    catch (const std::exception &e) {
+        throw std::runtime_error(fmt::format("Error loading index '{}': {}", input_path.string(), e.what()));
+    }
+}
+
+/**
+ * @brief Private helper function to create an error for a malformed index, worded like the other index errors.
+ *
+ * @param input_path Path to the index file (e.g., "~/header-warden.idx").
+ * @param reason What is wrong with the index (e.g., "File is too small").
+ *
+ * @return Error to throw.
+ */
+[[nodiscard]] std::runtime_error index_error(const std::filesystem::path &input_path,
+                                             const std::string_view reason)
+{
+    return std::runtime_error(fmt::format("Error loading index '{}': {}", input_path.string(), reason));
+}
+
+}  // namespace
+
+void IndexWriter::add(const std::filesystem::path &path,
+                      const analyze::CodeParser &parser)
+{
+    const auto &occurrences = parser.get_occurrences();
+    if (occurrences.empty()) {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(this->mutex_);
+    const auto file = static_cast<std::uint32_t>(this->files_.size());
+    this->files_.emplace_back(path.string());
+    const auto &numbers = occurrences.get_numbers();
+    const auto &functions = occurrences.get_functions();
+    const auto &kinds = occurrences.get_kinds();
+    for (std::size_t i = 0; i < occurrences.size(); ++i) {
+        this->postings_[functions[i]].push_back({file, numbers[i], kinds[i]});
+    }
+}
+
+void IndexWriter::write(const std::filesystem::path &output_path) const
+{
+    const std::lock_guard<std::mutex> lock(this->mutex_);
+
+    // Sort the files by path, so that the index is identical regardless of the order in which the threads added them
+    std::vector<std::uint32_t> file_order(this->files_.size());
+    for (std::size_t i = 0; i < file_order.size(); ++i) {
+        file_order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(file_order.begin(), file_order.end(), [this](const std::uint32_t a, const std::uint32_t b) {
+        return this->files_[a] < this->files_[b];
+    });
+    std::vector<std::uint32_t> file_rank(this->files_.size());
+    for (std::size_t i = 0; i < file_order.size(); ++i) {
+        file_rank[file_order[i]] = static_cast<std::uint32_t>(i);
+    }
+
+    // Sort the functions by name, so that the reader can binary-search them
+    std::vector<std::pair<std::string_view, const std::vector<Posting> *>> functions;
+    functions.reserve(this->postings_.size());
+    for (const auto &[function, postings] : this->postings_) {
+        functions.emplace_back(core::symbols::get_name(function), &postings);
+    }
+    std::sort(functions.begin(), functions.end());
+
+    // Lay out the string blob and the tables
+    std::string strings;
+    std::vector<StringRecord> file_records;
+    file_records.reserve(file_order.size());
+    for (const auto file : file_order) {
+        file_records.push_back({strings.size(), this->files_[file].size()});
+        strings += this->files_[file];
+    }
+    std::vector<FunctionRecord> function_records;
+    function_records.reserve(functions.size());
+    std::vector<PostingRecord> posting_records;
+    for (const auto &[function, postings] : functions) {
+        function_records.push_back({{strings.size(), function.size()}, posting_records.size(), postings->size()});
+        strings += function;
+        const std::size_t first = posting_records.size();
+        for (const auto &posting : *postings) {
+            posting_records.push_back({file_rank[posting.file], posting.number, static_cast<std::uint32_t>(posting.kind)});
+        }
+        std::sort(posting_records.begin() + static_cast<std::ptrdiff_t>(first), posting_records.end(), [](const PostingRecord &a, const PostingRecord &b) {
+            return std::tie(a.file, a.number, a.kind) < std::tie(b.file, b.number, b.kind);
+        });
+    }
+
+    // Lay out the whole index in memory, then replace the target atomically, so that readers never see a partial index
+    std::string bytes;
+    bytes.reserve(sizeof(HeaderRecord) + file_records.size() * sizeof(StringRecord) + function_records.size() * sizeof(FunctionRecord) +
+                  posting_records.size() * sizeof(PostingRecord) + strings.size());
+    store(bytes, HeaderRecord{index_magic, file_records.size(), function_records.size(), posting_records.size(), strings.size()});
+    for (const auto &record : file_records) {
+        store(bytes, record);
+    }
+    for (const auto &record : function_records) {
+        store(bytes, record);
+    }
+    for (const auto &record : posting_records) {
+        store(bytes, record);
+    }
+    bytes += strings;
+    core::io::write_text_atomically(output_path, bytes);
+}
+
+IndexReader::IndexReader(const std::filesystem::path &input_path)
+    : path_(input_path), file_(map_index(input_path))
+{
+    // Validate only the header and the table sizes, so that opening the index does not depend on its size
+    // The records are checked when a query reads them, see find()
+    const std::size_t size = this->file_.size();
+    if (size < sizeof(HeaderRecord)) {
+        throw index_error(this->path_, "File is too small");
+    }
+    const auto header = load<HeaderRecord>(this->file_.data(), 0);
+    if (header.magic != index_magic) {
+        throw index_error(this->path_, "Not an index file or unsupported version");
+    }
+
+    // Compare each count against the bytes that are left before multiplying, so that a corrupted count cannot overflow
+    std::uint64_t remaining = size - sizeof(HeaderRecord);
+    const auto take = [&remaining](const std::uint64_t count, const std::size_t record_size) {
+        if (count > remaining / record_size) {
+            return false;
+        }
+        remaining -= count * record_size;
+        return true;
+    };
+    if (!take(header.file_count, sizeof(StringRecord)) || !take(header.function_count, sizeof(FunctionRecord)) ||
+        !take(header.posting_count, sizeof(PostingRecord)) || header.strings_size != remaining) {
+        throw index_error(this->path_, "File is truncated or corrupted");
+    }
+}
+
+std::vector<Hit> IndexReader::find(const std::string_view function) const
+{
+    const char *data = this->file_.data();
+    const auto header = load<HeaderRecord>(data, 0);
+    const std::size_t files_offset = sizeof(HeaderRecord);
+    const std::size_t functions_offset = files_offset + header.file_count * sizeof(StringRecord);
+    const std::size_t postings_offset = functions_offset + header.function_count * sizeof(FunctionRecord);
+    const std::size_t strings_offset = postings_offset + header.posting_count * sizeof(PostingRecord);
+
+    // Resolve a string record to a view into the mapped string blob, the table sizes were validated on load, but the record itself was not
+    const auto view = [this, data, &header, strings_offset](const StringRecord &record) {
+        if (record.offset > header.strings_size || record.length > header.strings_size - record.offset) {
+            throw index_error(this->path_, "String is out of bounds");
+        }
+        return std::string_view(data + strings_offset + record.offset, record.length);
+    };
+
+    // Binary search the sorted function table
+    std::size_t low = 0;
+    std::size_t high = header.function_count;
+    while (low < high) {
+        const std::size_t middle = low + (high - low) / 2;
+        if (view(load<FunctionRecord>(data, functions_offset + middle * sizeof(FunctionRecord)).name) < function) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    if (low == header.function_count) {
+        return {};
+    }
+    const auto record = load<FunctionRecord>(data, functions_offset + low * sizeof(FunctionRecord));
+    if (view(record.name) != function) {
+        return {};
+    }
+    if (record.first_posting > header.posting_count || record.posting_count > header.posting_count - record.first_posting) {
+        throw index_error(this->path_, "Function record is out of bounds");
+    }
+
+    // Collect the postings of the function, each of which must refer to an indexed file
+    std::vector<Hit> hits;
+    hits.reserve(record.posting_count);
+    for (std::uint64_t i = 0; i < record.posting_count; ++i) {
+        const auto posting = load<PostingRecord>(data, postings_offset + (record.first_posting + i) * sizeof(PostingRecord));
+        if (posting.file >= header.file_count || posting.kind > static_cast<std::uint32_t>(analyze::Occurrence::Kind::Listed)) {
+            throw index_error(this->path_, "Posting refers to a missing file or an unknown kind");
+        }
+        hits.push_back({view(load<StringRecord>(data, files_offset + posting.file * sizeof(StringRecord))),
+                        posting.number,
+                        static_cast<analyze::Occurrence::Kind>(posting.kind)});
+    }
+    return hits;
+}
+
+std::size_t IndexReader::get_file_count() const
+{
+    return load<HeaderRecord>(this->file_.data(), 0).file_count;
+}
+
+}  // namespace modules::index
@@ -0,0 +1,149 @@
+/**
+ * @file index.hpp
+ *
+ * @brief Build and query a persistent, memory-mappable index of standard functions.
+ */
+
+#pragma once
+
+#include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint32_t
+#include <filesystem>     // for std::filesystem
+#include <mutex>          // for std::mutex
+#include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <unordered_map>  // for std::unordered_map
+#include <vector>         // for std::vector
+
+#include "core/mmap.hpp"
+#include "core/symbols.hpp"
+#include "modules/analyze.hpp"
+
+namespace modules::index {
+
+/**
+ * @brief Struct that represents a single result of an index query.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct Hit final {
+    /**
+     * @brief Path to the file where the function occurs (e.g., "~/src/app.cpp").
+     */
+    std::string_view file;
+
+    /**
+     * @brief Line number of the occurrence (e.g., "31").
+     */
+    std::uint32_t number;
+
+    /**
+     * @brief How the function occurs in the code (e.g., "Kind::Used").
+     */
+    analyze::Occurrence::Kind kind;
+};
+
+/**
+ * @brief Class that collects occurrences of standard functions from many files and writes them as an inverted index.
+ *
+ * The index maps each function (e.g., "std::regex") to the files and lines where it is used or listed. It is written in a native-endian binary format that can be memory-mapped and binary-searched without parsing.
+ *
+ * @note This class is marked as `final` to prevent inheritance. The "add" member function is thread-safe.
+ */
+class IndexWriter final {
+  public:
+    /**
+     * @brief Add all occurrences of a parsed file to the index.
+     *
+     * @param path Path to the parsed file (e.g., "~/src/app.cpp").
+     * @param parser Parsed file.
+     */
+    void add(const std::filesystem::path &path,
+             const analyze::CodeParser &parser);
+
+    /**
+     * @brief Write the index to disk.
+     *
+     * The index is replaced atomically with "core::io::write_text_atomically", so that readers never see a partially written index.
+     *
+     * @param output_path Path to the index file (e.g., "~/header-warden.idx").
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void write(const std::filesystem::path &output_path) const;
+
+  private:
+    /**
+     * @brief Struct that represents a single occurrence in memory, before the index is written.
+     */
+    struct Posting final {
+        std::uint32_t file;
+        std::uint32_t number;
+        analyze::Occurrence::Kind kind;
+    };
+
+    /**
+     * @brief Mutex that protects the members below.
+     */
+    mutable std::mutex mutex_;
+
+    /**
+     * @brief Vector of file paths, indexed by file ID.
+     */
+    std::vector<std::string> files_;
+
+    /**
+     * @brief Map of interned functions to their postings, the names are only looked up when the index is written.
+     */
+    std::unordered_map<core::symbols::Id, std::vector<Posting>> postings_;
+};
+
+/**
+ * @brief Class that answers queries from an index written by "IndexWriter".
+ *
+ * On construction, the index is memory-mapped and validated. Queries binary-search the mapped function table, so no parsing is needed.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class IndexReader final {
+  public:
+    /**
+     * @brief Construct a new IndexReader object.
+     *
+     * @param input_path Path to the index file (e.g., "~/header-warden.idx").
+     *
+     * @throws std::runtime_error If the file cannot be mapped, or its header or table sizes are invalid.
+     */
+    explicit IndexReader(const std::filesystem::path &input_path);
+
+    /**
+     * @brief Find all occurrences of a standard function.
+     *
+     * @param function Function prefixed with "std::" in lowercase (e.g., "std::regex").
+     *
+     * @return Vector of hits in file and line order. The file names point into the mapped index, so they are valid as long as this object is alive.
+     *
+     * @throws std::runtime_error If a record read by the query is out of bounds.
+     */
+    [[nodiscard]] std::vector<Hit> find(std::string_view function) const;
+
+    /**
+     * @brief Get the number of files in the index.
+     *
+     * @return Number of indexed files (e.g., "42").
+     */
+    [[nodiscard]] std::size_t get_file_count() const;
+
+  private:
+    /**
+     * @brief Path to the index file, used in the errors of the queries.
+     */
+    const std::filesystem::path path_;
+
+    /**
+     * @brief Memory-mapped index file.
+     */
+    const core::mmap::MappedFile file_;
+};
+
+}  // namespace modules::index
@@ -162,4 +162,77 @@ const std::size_t pi = 3.14159;
 std::sort(v.begin(), v.end());
 std::cout << "Hello world!\n";)";
 
+inline constexpr std::string_view fixable = R"(#include <algorithm>  // for std::find
+#include <cstddef>
+#include <vector>    // for std::vector
+
+std::vector<int> v = {3, 1, 2};
+std::sort(v.begin(), v.end());
+const std::size_t size = v.size();
+const std::string name = "fixable";
+)";
+
+inline constexpr std::string_view missing_includes = R"(#pragma once
+
+#include <cstddef>  // for std::size_t
+#include <vector>   // for std::vector
+
+#include <fmt/core.h>
+
+std::vector<std::string> names;
+std::sort(names.begin(), names.end());
+const std::size_t count = names.size();
+std::cout << count;
+)";
+
+inline constexpr std::string_view redundant = R"(#include <algorithm>  // for std::sort
+#include <map>        // for std::map
+#include <cstdlib>    // for EXIT_SUCCESS
+#include <iostream>
+#include <sstream>
+#include <fmt/core.h>
+
+std::sort(v.begin(), v.end());
+std::cout << "Hello world!\n";)";
+
+inline constexpr std::string_view misattributed = R"(#include <algorithm>  // for std::trasform, std::swap
+#include <cstdio>     // for std::size_t
+#include <vector>     // for std::vector, std::sort
+#include <string>     // for std::pmr::string
+
+std::vector<int> v = {3, 1, 2};
+std::sort(v.begin(), v.end());
+std::swap(v[0], v[1]);
+const std::size_t size = v.size();
+const std::pmr::string name = "v";)";
+
+inline constexpr std::string_view graph_header = R"(#pragma once
+
+#include <string>  // for std::string
+#include <vector>  // for std::vector
+
+#include "lib/detail.hpp"
+
+std::vector<std::string> split(const std::string &text);)";
+
+inline constexpr std::string_view graph_detail = R"(#pragma once
+
+#include <cstddef>  // for std::size_t
+
+#include "graph.hpp"
+
+std::size_t count(const char *text);)";
+
+inline constexpr std::string_view graph_source = R"(#include <algorithm>  // for std::sort
+
+#include "graph.hpp"
+
+std::vector<std::string> split(const std::string &text)
+{
+    const std::size_t size = count(text.c_str());
+    std::vector<std::string> result(size, std::string());
+    std::sort(result.begin(), result.end());
+    return result;
+})";
+
 }  // namespace examples
@@ -6,12 +6,20 @@
 
 #pragma once
 
+#include <cstddef>     // for std::size_t
+#include <cstdio>      // for std::FILE, std::fopen, std::fclose
 #include <filesystem>  // for std::filesystem
+#include <memory>      // for std::unique_ptr
+#include <stdexcept>   // for std::runtime_error
+#include <string>      // for std::string
 #include <vector>      // for std::vector
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
+#include "app.hpp"
+#include "core/args.hpp"
+#include "core/io.hpp"
 #include "modules/analyze.hpp"
 
 namespace helpers {
@@ -66,6 +74,27 @@ class TempDir final {
     const std::filesystem::path directory_;
 };
 
+/**
+ * @brief Run the app and capture what it prints to its output, e.g., to check that a patch printed in diff mode is clean.
+ *
+ * @param args Parsed command-line arguments.
+ * @param capture_path Path to a file that receives the output (e.g., "~/data/out.txt").
+ *
+ * @return Everything the app printed to its output.
+ */
+[[nodiscard]] inline std::string run_and_capture(const core::args::Args &args,
+                                                 const std::filesystem::path &capture_path)
+{
+    {
+        const std::unique_ptr<std::FILE, int (*)(std::FILE *)> out(std::fopen(capture_path.string().c_str(), "wb"), &std::fclose);
+        if (!out) {
+            throw std::runtime_error("Failed to open capture file for writing");
+        }
+        app::run(args, out.get());
+    }
+    return core::io::read_text(capture_path);
+}
+
 /**
  * @brief Compare program-generated bare includes with expected bare includes.
  *
@@ -130,19 +159,43 @@ class TempDir final {
     return true;
 }
 
+/**
+ * @brief Struct that represents an unlisted function with its strings rendered, so that the expected results can be written out in full.
+ *
+ * @note This struct is marked as `final` to prevent inheritance.
+ */
+struct RenderedUnlistedFunction final {
+    std::size_t number;
+    std::string text;
+    std::string function;
+    std::string link;
+
+    [[nodiscard]] bool operator==(const RenderedUnlistedFunction &other) const
+    {
+        return number == other.number && text == other.text && function == other.function && link == other.link;
+    }
+};
+
 /**
  * @brief Compare program-generated unlisted functions with expected unlisted functions.
  *
- * This also prints the results to the console.
+ * The compact records of the parser are rendered through its accessors first. This also prints the results to the console.
  *
- * @param program Program-generated unlisted functions.
+ * @param parser Parser that generated the unlisted functions.
  * @param expected Expected unlisted functions.
  *
  * @return True if the program-generated unlisted functions match the expected unlisted functions, false otherwise.
  */
-[[nodiscard]] inline bool compare_and_print_unlisted_functions(const std::vector<modules::analyze::UnlistedFunction> &program,
-                                                               const std::vector<modules::analyze::UnlistedFunction> &expected)
+[[nodiscard]] inline bool compare_and_print_unlisted_functions(const modules::analyze::CodeParser &parser,
+                                                               const std::vector<RenderedUnlistedFunction> &expected)
 {
+    std::vector<RenderedUnlistedFunction> program;
+    const auto &unlisted_functions = parser.get_unlisted_functions();
+    for (std::size_t i = 0; i < unlisted_functions.size(); ++i) {
+        const auto entry = unlisted_functions.get(i);
+        program.push_back({entry.number, std::string(parser.get_line(entry.number)), std::string(entry.get_function()), entry.get_link()});
+    }
+
     if (program != expected) {
         fmt::print(stderr, "Unlisted functions test failed.\nExpected:\n");
         for (const auto &entry : expected) {
@@ -162,4 +215,71 @@ class TempDir final {
     return true;
 }
 
+/**
+ * @brief Compare program-generated redundant includes with expected redundant includes.
+ *
+ * This also prints the results to the console.
+ *
+ * @param program Program-generated redundant includes.
+ * @param expected Expected redundant includes.
+ *
+ * @return True if the program-generated redundant includes match the expected redundant includes, false otherwise.
+ */
+[[nodiscard]] inline bool compare_and_print_redundant_includes(const std::vector<modules::analyze::RedundantInclude> &program,
+                                                               const std::vector<modules::analyze::RedundantInclude> &expected)
+{
+    if (program != expected) {
+        fmt::print(stderr, "Redundant includes test failed.\nExpected:\n");
+        for (const auto &entry : expected) {
+            fmt::print(stderr, "  Line '{}': '{}', Header: '{}'\n", entry.number, entry.text, entry.header);
+        }
+        fmt::print(stderr, "Actual:\n");
+        for (const auto &entry : program) {
+            fmt::print(stderr, "  Line '{}': '{}', Header: '{}'\n", entry.number, entry.text, entry.header);
+        }
+        return false;
+    }
+
+    fmt::print("Redundant includes test succeeded.\n");
+    for (const auto &entry : program) {
+        fmt::print("  Line '{}': '{}', Header: '{}'\n", entry.number, entry.text, entry.header);
+    }
+    return true;
+}
+
+/**
+ * @brief Compare program-generated misattributed functions with expected misattributed functions.
+ *
+ * This also prints the results to the console.
+ *
+ * @param program Program-generated misattributed functions.
+ * @param expected Expected misattributed functions.
+ *
+ * @return True if the program-generated misattributed functions match the expected misattributed functions, false otherwise.
+ */
+[[nodiscard]] inline bool compare_and_print_misattributed_functions(const std::vector<modules::analyze::MisattributedFunction> &program,
+                                                                    const std::vector<modules::analyze::MisattributedFunction> &expected)
+{
+    const auto kind_to_string = [](const modules::analyze::MisattributedFunction::Kind kind) {
+        return kind == modules::analyze::MisattributedFunction::Kind::WrongHeader ? "wrong header" : "unknown function";
+    };
+    if (program != expected) {
+        fmt::print(stderr, "Misattributed functions test failed.\nExpected:\n");
+        for (const auto &entry : expected) {
+            fmt::print(stderr, "  Line '{}': '{}', Function: '{}', Header: '{}', Kind: '{}', Suggestion: '{}'\n", entry.number, entry.text, entry.function, entry.header, kind_to_string(entry.kind), entry.suggestion);
+        }
+        fmt::print(stderr, "Actual:\n");
+        for (const auto &entry : program) {
+            fmt::print(stderr, "  Line '{}': '{}', Function: '{}', Header: '{}', Kind: '{}', Suggestion: '{}'\n", entry.number, entry.text, entry.function, entry.header, kind_to_string(entry.kind), entry.suggestion);
+        }
+        return false;
+    }
+
+    fmt::print("Misattributed functions test succeeded.\n");
+    for (const auto &entry : program) {
+        fmt::print("  Line '{}': '{}', Function: '{}', Header: '{}', Kind: '{}', Suggestion: '{}'\n", entry.number, entry.text, entry.function, entry.header, kind_to_string(entry.kind), entry.suggestion);
+    }
+    return true;
+}
+
 }  // namespace helpers
@@ -3,15 +3,25 @@
  */
 
 #include <algorithm>      // for std::sort
+#include <array>          // for std::array
+#include <chrono>         // for std::chrono
 #include <cstddef>        // for std::size_t
+#include <cstdint>        // for std::uint32_t
 #include <cstdlib>        // for EXIT_FAILURE, EXIT_SUCCESS
+#include <cstring>        // for std::memcpy
 #include <exception>      // for std::exception
 #include <filesystem>     // for std::filesystem
-#include <fstream>        // for std::ofstream
+#include <fstream>        // for std::ofstream, std::ifstream
 #include <functional>     // for std::function
+#include <ios>            // for std::ios, std::streamsize
+#include <iterator>       // for std::istreambuf_iterator, std::distance
 #include <stdexcept>      // for std::runtime_error
 #include <string>         // for std::string
+#include <string_view>    // for std::string_view
+#include <thread>         // for std::thread
+#include <tuple>          // for std::tuple
 #include <unordered_map>  // for std::unordered_map
+#include <utility>        // for std::move
 #include <vector>         // for std::vector
 
 #include <fmt/core.h>
@@ -23,8 +33,19 @@
 
 #include "app.hpp"
 #include "core/args.hpp"
+#include "core/channel.hpp"
+#include "core/diff.hpp"
+#include "core/io.hpp"
+#include "core/perf.hpp"
+#include "core/stats.hpp"
 #include "core/string.hpp"
+#include "core/symbols.hpp"
+#include "core/trace.hpp"
+#include "modules/aggregate.hpp"
 #include "modules/analyze.hpp"
+#include "modules/fix.hpp"
+#include "modules/graph.hpp"
+#include "modules/index.hpp"
 
 #include "examples.hpp"
 #include "helpers.hpp"
@@ -35,6 +56,7 @@ namespace test_args {
 [[nodiscard]] int none();
 [[nodiscard]] int invalid();
 [[nodiscard]] int paths();
+[[nodiscard]] int compile_commands();
 }  // namespace test_args
 
 namespace test_analyze {
@@ -43,10 +65,38 @@ namespace test_analyze {
 [[nodiscard]] int analyze_bare();
 [[nodiscard]] int analyze_unused();
 [[nodiscard]] int analyze_unlisted();
+[[nodiscard]] int analyze_redundant();
+[[nodiscard]] int analyze_misattributed();
 }  // namespace test_analyze
 
+namespace test_graph {
+[[nodiscard]] int inherited();
+[[nodiscard]] int paired();
+}  // namespace test_graph
+
+namespace test_fix {
+[[nodiscard]] int rewrite();
+[[nodiscard]] int diff();
+[[nodiscard]] int insert();
+}  // namespace test_fix
+
+namespace test_index {
+[[nodiscard]] int query();
+}  // namespace test_index
+
+namespace test_aggregate {
+[[nodiscard]] int top();
+}  // namespace test_aggregate
+
+namespace test_stats {
+[[nodiscard]] int collect();
+[[nodiscard]] int trace();
+}  // namespace test_stats
+
 namespace test_app {
 [[nodiscard]] int paths();
+[[nodiscard]] int discover();
+[[nodiscard]] int channel();
 }  // namespace test_app
 
 /**
@@ -86,12 +136,26 @@ int main(int argc,
         {"test_args::none", test_args::none},
         {"test_args::invalid", test_args::invalid},
         {"test_args::paths", test_args::paths},
+        {"test_args::compile_commands", test_args::compile_commands},
         {"test_analyze::analyze_badly_formatted", test_analyze::analyze_badly_formatted},
         {"test_analyze::analyze_no_issues", test_analyze::analyze_no_issues},
         {"test_analyze::analyze_bare", test_analyze::analyze_bare},
         {"test_analyze::analyze_unused", test_analyze::analyze_unused},
         {"test_analyze::analyze_unlisted", test_analyze::analyze_unlisted},
+        {"test_analyze::analyze_redundant", test_analyze::analyze_redundant},
+        {"test_analyze::analyze_misattributed", test_analyze::analyze_misattributed},
+        {"test_graph::inherited", test_graph::inherited},
+        {"test_graph::paired", test_graph::paired},
+        {"test_fix::rewrite", test_fix::rewrite},
+        {"test_fix::diff", test_fix::diff},
+        {"test_fix::insert", test_fix::insert},
+        {"test_index::query", test_index::query},
+        {"test_aggregate::top", test_aggregate::top},
+        {"test_stats::collect", test_stats::collect},
+        {"test_stats::trace", test_stats::trace},
         {"test_app::paths", test_app::paths},
+        {"test_app::discover", test_app::discover},
+        {"test_app::channel", test_app::channel},
     };
 
     // Get the test name from the command-line arguments
@@ -206,17 +270,31 @@ int test_args::paths()
         char *fake_argv[] = {test_executable_name, temp_dir_cstr.data()};
         const core::args::Args args(2, fake_argv);
 
-        // Compare the filepaths found by Args
-        if (args.filepaths.size() != 2) {
+        // The directory is kept as the only input, its files are only found by walking it
+        if (args.inputs.size() != 1 || !std::filesystem::equivalent(args.inputs.front(), temp_dir.get())) {
+            fmt::print(stderr,
+                       "Filepaths test failed: expected '{}', got: {}\n",
+                       temp_dir_str,
+                       fmt::join(core::string::paths_to_strings(args.inputs), ", "));
+            return EXIT_FAILURE;
+        }
+
+        // Compare the filepaths found by walking the inputs
+        std::vector<std::filesystem::path> filepaths;
+        core::args::FileWalker walker(args.inputs);
+        while (auto path = walker.next()) {
+            filepaths.emplace_back(std::move(*path));
+        }
+        if (filepaths.size() != 2) {
             fmt::print(stderr,
                        "Filepaths test failed: expected 2, got {}: {}\n",
-                       args.filepaths.size(),
-                       fmt::join(core::string::paths_to_strings(args.filepaths), ", "));
+                       filepaths.size(),
+                       fmt::join(core::string::paths_to_strings(filepaths), ", "));
             return EXIT_FAILURE;
         }
 
         // Iterate, because the order is not guaranteed
-        for (const auto &path : args.filepaths) {
+        for (const auto &path : filepaths) {
             if (!std::filesystem::equivalent(path, temp_file1) && !std::filesystem::equivalent(path, temp_file2)) {
                 fmt::print(stderr,
                            "Filepaths test failed: expected '{}' or '{}', got '{}'\n",
@@ -236,6 +314,83 @@ int test_args::paths()
     }
 }
 
+int test_args::compile_commands()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Two dummy CPP files, one C file that must be skipped, and two include directories
+        const auto source_dir = temp_dir.get() / "src dir";
+        std::filesystem::create_directories(source_dir);
+        std::filesystem::create_directories(temp_dir.get() / "include");
+        for (const auto *name : {"main.cpp", "util.cpp", "legacy.c"}) {
+            std::ofstream f(source_dir / name);
+            if (!f) {
+                throw std::runtime_error("Failed to open source file for writing");
+            }
+            f << examples::unlisted;
+        }
+
+        // Write a compilation database using both the "arguments" and the "command" forms, with escapes and unknown keys
+        const auto database = temp_dir.get() / "compile_commands.json";
+        {
+            std::ofstream f(database);
+            if (!f) {
+                throw std::runtime_error("Failed to open database for writing");
+            }
+            const std::string directory = temp_dir.get().generic_string();
+            f << "[\n"
+              << "  {\"directory\": \"" << directory << "\", \"arguments\": [\"c++\", \"-I\", \"include\", \"-c\", \"src dir/main.cpp\"], \"file\": \"src dir/main.cpp\"},\n"
+              << "  {\"output\": {\"nested\": [1, 2.5e3, true, null]}, \"directory\": \"" << directory << "\", \"command\": \"c++ -I\\\"src dir\\\" -Iinclude -c \\\"src dir/util.cpp\\\"\", \"file\": \"src\\u0020dir/util.cpp\"},\n"
+              << "  {\"directory\": \"" << directory << "\", \"command\": \"cc -c 'src dir/legacy.c'\", \"file\": \"src dir/legacy.c\"}\n"
+              << "]\n";
+        }
+
+        // Build the argv array with mutable strings
+        char test_executable_name[] = TEST_EXECUTABLE_NAME;
+        char arg_compile_commands[] = "--compile-commands";
+        const std::string database_str = database.string();
+        std::vector<char> database_cstr(database_str.cbegin(), database_str.cend());
+        database_cstr.emplace_back('\0');  // Ensure null-termination
+        char *fake_argv[] = {test_executable_name, arg_compile_commands, database_cstr.data()};
+        const core::args::Args args(3, fake_argv);
+
+        // Compare the filepaths, the order of the database is preserved
+        const std::vector<std::filesystem::path> expected_filepaths = {source_dir / "main.cpp", source_dir / "util.cpp"};
+        if (args.inputs != expected_filepaths) {
+            fmt::print(stderr,
+                       "Compile commands test failed: expected '{}', got '{}'\n",
+                       fmt::join(core::string::paths_to_strings(expected_filepaths), ", "),
+                       fmt::join(core::string::paths_to_strings(args.inputs), ", "));
+            return EXIT_FAILURE;
+        }
+
+        // Compare the include directories, duplicates are removed
+        const std::vector<std::filesystem::path> expected_include_directories = {temp_dir.get() / "include", source_dir};
+        if (args.include_directories != expected_include_directories) {
+            fmt::print(stderr,
+                       "Compile commands test failed: expected include directories '{}', got '{}'\n",
+                       fmt::join(core::string::paths_to_strings(expected_include_directories), ", "),
+                       fmt::join(core::string::paths_to_strings(args.include_directories), ", "));
+            return EXIT_FAILURE;
+        }
+
+        // The include graph is used to discover headers
+        if (!args.enable.include_graph || !args.enable.discover_headers) {
+            fmt::print(stderr, "Compile commands test failed: include graph and header discovery should be enabled.\n");
+            return EXIT_FAILURE;
+        }
+
+        fmt::print("test_args::compile_commands() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_args::compile_commands() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
 int test_analyze::analyze_badly_formatted()
 {
     try {
@@ -261,8 +416,8 @@ int test_analyze::analyze_badly_formatted()
             modules::analyze::IncludeWithUnusedFunctions(12, "#include <algorithm>  //     for std::find", {"std::find"}),
             modules::analyze::IncludeWithUnusedFunctions(15, "    #INCLUDE <ITERATOR>  // for std::back_inserter, std::transform", {"std::back_inserter", "std::transform"}),
         };
-        const std::vector<modules::analyze::UnlistedFunction> expected_unlisted_functions = {
-            modules::analyze::UnlistedFunction(35, "    STD::SORT(RESULT.BEGIN(), RESULT.END());", "std::sort", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asort&ia=web"),
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {
+            helpers::RenderedUnlistedFunction{35, "    STD::SORT(RESULT.BEGIN(), RESULT.END());", "std::sort", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asort&ia=web"},
         };
 
         // Analyze the temporary file
@@ -279,7 +434,7 @@ int test_analyze::analyze_badly_formatted()
         }
 
         // Compare unlisted functions
-        if (!helpers::compare_and_print_unlisted_functions(parser.get_unlisted_functions(), expected_unlisted_functions)) {
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
             throw std::runtime_error("Unlisted functions test failed.");
         }
 
@@ -311,7 +466,7 @@ int test_analyze::analyze_no_issues()
         // Create expected results
         const std::vector<modules::analyze::BareInclude> expected_bare_includes = {};
         const std::vector<modules::analyze::IncludeWithUnusedFunctions> expected_unused_functions = {};
-        const std::vector<modules::analyze::UnlistedFunction> expected_unlisted_functions = {};
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {};
 
         // Analyze the temporary file
         modules::analyze::CodeParser parser(temp_file);
@@ -327,7 +482,7 @@ int test_analyze::analyze_no_issues()
         }
 
         // Compare unlisted functions
-        if (!helpers::compare_and_print_unlisted_functions(parser.get_unlisted_functions(), expected_unlisted_functions)) {
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
             throw std::runtime_error("Unlisted functions test failed.");
         }
 
@@ -362,7 +517,7 @@ int test_analyze::analyze_bare()
             modules::analyze::BareInclude(9, "#include<pathmaster/pathmaster.hpp>", "#include<pathmaster/pathmaster.hpp>"),
         };
         const std::vector<modules::analyze::IncludeWithUnusedFunctions> expected_unused_functions = {};
-        const std::vector<modules::analyze::UnlistedFunction> expected_unlisted_functions = {};
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {};
 
         // Analyze the temporary file
         modules::analyze::CodeParser parser(temp_file);
@@ -378,7 +533,7 @@ int test_analyze::analyze_bare()
         }
 
         // Compare unlisted functions
-        if (!helpers::compare_and_print_unlisted_functions(parser.get_unlisted_functions(), expected_unlisted_functions)) {
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
             throw std::runtime_error("Unlisted functions test failed.");
         }
 
@@ -415,7 +570,7 @@ int test_analyze::analyze_unused()
             modules::analyze::IncludeWithUnusedFunctions(4, "#include <ALGORITHM>//for std::find, STD::TRANSFORM, std::back_inserter", {"std::find", "std::transform", "std::back_inserter"}),
             modules::analyze::IncludeWithUnusedFunctions(5, "#include <cstddef>        // for std::size_t,        std::nullptr_t", {"std::nullptr_t"}),
         };
-        const std::vector<modules::analyze::UnlistedFunction> expected_unlisted_functions = {};
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {};
 
         // Analyze the temporary file
         modules::analyze::CodeParser parser(temp_file);
@@ -431,7 +586,7 @@ int test_analyze::analyze_unused()
         }
 
         // Compare unlisted functions
-        if (!helpers::compare_and_print_unlisted_functions(parser.get_unlisted_functions(), expected_unlisted_functions)) {
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
             throw std::runtime_error("Unlisted functions test failed.");
         }
 
@@ -463,9 +618,9 @@ int test_analyze::analyze_unlisted()
         // Create expected results
         const std::vector<modules::analyze::BareInclude> expected_bare_includes = {};
         const std::vector<modules::analyze::IncludeWithUnusedFunctions> expected_unused_functions = {};
-        const std::vector<modules::analyze::UnlistedFunction> expected_unlisted_functions = {
-            modules::analyze::UnlistedFunction(3, "const std::size_t pi = 3.14159;", "std::size_t", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asize_t&ia=web"),
-            modules::analyze::UnlistedFunction(4, "std::sort(v.begin(), v.end());", "std::sort", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asort&ia=web"),
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {
+            helpers::RenderedUnlistedFunction{3, "const std::size_t pi = 3.14159;", "std::size_t", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asize_t&ia=web"},
+            helpers::RenderedUnlistedFunction{4, "std::sort(v.begin(), v.end());", "std::sort", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asort&ia=web"},
         };
 
         // Analyze the temporary file
@@ -482,10 +637,18 @@ int test_analyze::analyze_unlisted()
         }
 
         // Compare unlisted functions
-        if (!helpers::compare_and_print_unlisted_functions(parser.get_unlisted_functions(), expected_unlisted_functions)) {
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
             throw std::runtime_error("Unlisted functions test failed.");
         }
 
+        // Known and unknown functions are interned to stable IDs that render back to the same name
+        const core::symbols::Id sort = core::symbols::intern("std::sort");
+        const core::symbols::Id unknown = core::symbols::intern("std::not_in_the_table");
+        if (sort != parser.get_unlisted_functions().get_functions().back() || core::symbols::get_name(sort) != "std::sort" ||
+            unknown != core::symbols::intern("std::not_in_the_table") || unknown == sort || core::symbols::get_name(unknown) != "std::not_in_the_table") {
+            throw std::runtime_error("Symbol interning test failed.");
+        }
+
         fmt::print("test_analyze::analyze_unlisted() passed.\n");
         return EXIT_SUCCESS;
     }
@@ -495,6 +658,860 @@ int test_analyze::analyze_unlisted()
     }
 }
 
+int test_analyze::analyze_redundant()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a temporary file
+        const auto temp_file = temp_dir.get() / "redundant.cpp";
+        {
+            std::ofstream f(temp_file);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_file for writing");
+            }
+            f << examples::redundant;
+        }
+
+        // Create expected results
+        // <iostream> is bare but provides "std::cout", <cstdlib> documents a macro, and <fmt/core.h> is not a standard header
+        const std::vector<modules::analyze::RedundantInclude> expected_redundant_includes = {
+            modules::analyze::RedundantInclude(2, "#include <map>        // for std::map", "map"),
+            modules::analyze::RedundantInclude(5, "#include <sstream>", "sstream"),
+        };
+
+        // Analyze the temporary file
+        modules::analyze::CodeParser parser(temp_file);
+
+        // Compare redundant includes
+        if (!helpers::compare_and_print_redundant_includes(parser.get_redundant_includes(), expected_redundant_includes)) {
+            throw std::runtime_error("Redundant includes test failed.");
+        }
+
+        fmt::print("test_analyze::analyze_redundant() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_analyze::analyze_redundant() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_analyze::analyze_misattributed()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a temporary file
+        const auto temp_file = temp_dir.get() / "misattributed.cpp";
+        {
+            std::ofstream f(temp_file);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_file for writing");
+            }
+            f << examples::misattributed;
+        }
+
+        // Create expected results
+        // "std::swap" and "std::size_t" are provided by several headers, including the ones they are listed after, and "std::pmr::string" by <string>
+        const std::vector<modules::analyze::MisattributedFunction> expected_misattributed_functions = {
+            modules::analyze::MisattributedFunction(1, "#include <algorithm>  // for std::trasform, std::swap", "std::trasform", "algorithm", modules::analyze::MisattributedFunction::Kind::UnknownFunction, "std::transform"),
+            modules::analyze::MisattributedFunction(3, "#include <vector>     // for std::vector, std::sort", "std::sort", "vector", modules::analyze::MisattributedFunction::Kind::WrongHeader, "algorithm"),
+        };
+
+        // Analyze the temporary file
+        modules::analyze::CodeParser parser(temp_file);
+
+        // Compare misattributed functions
+        if (!helpers::compare_and_print_misattributed_functions(parser.get_misattributed_functions(), expected_misattributed_functions)) {
+            throw std::runtime_error("Misattributed functions test failed.");
+        }
+
+        // A polymorphic allocator alias is provided by the header of its container only, not by every header that declares a "std::pmr" alias
+        const auto temp_pmr = temp_dir.get() / "pmr.cpp";
+        {
+            std::ofstream f(temp_pmr);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_pmr for writing");
+            }
+            f << "#include <memory_resource>  // for std::pmr::monotonic_buffer_resource\n"
+              << "#include <vector>           // for std::pmr::string\n"
+              << "\n"
+              << "std::pmr::monotonic_buffer_resource arena;\n"
+              << "const std::pmr::string name(&arena);\n";
+        }
+        const std::vector<modules::analyze::MisattributedFunction> expected_pmr = {
+            modules::analyze::MisattributedFunction(2, "#include <vector>           // for std::pmr::string", "std::pmr::string", "vector", modules::analyze::MisattributedFunction::Kind::WrongHeader, "string"),
+        };
+        if (!helpers::compare_and_print_misattributed_functions(modules::analyze::CodeParser(temp_pmr).get_misattributed_functions(), expected_pmr)) {
+            throw std::runtime_error("Misattributed polymorphic allocator alias test failed.");
+        }
+
+        // The bit-parallel edit distance agrees with the dynamic programming fallback for strings longer than 64 characters
+        const std::string long_a(70, 'a');
+        const std::string long_b = std::string(35, 'a') + "b" + std::string(33, 'a');
+        if (core::string::edit_distance("std::trasform", "std::transform") != 1 || core::string::edit_distance("kitten", "sitting") != 3 ||
+            core::string::edit_distance("", "abc") != 3 || core::string::edit_distance(long_a, long_b) != 2 || core::string::edit_distance(long_b, long_a) != 2) {
+            throw std::runtime_error("Edit distance test failed.");
+        }
+
+        fmt::print("test_analyze::analyze_misattributed() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_analyze::analyze_misattributed() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_graph::inherited()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a source file, its header, and a header found only through an include directory
+        // The headers include each other, so that cyclic includes are covered as well
+        const auto source_dir = temp_dir.get() / "src";
+        const auto include_dir = temp_dir.get() / "include";
+        std::filesystem::create_directories(source_dir);
+        std::filesystem::create_directories(include_dir / "lib");
+        const auto temp_source = source_dir / "graph.cpp";
+        {
+            std::ofstream f1(temp_source);
+            std::ofstream f2(source_dir / "graph.hpp");
+            std::ofstream f3(include_dir / "lib" / "detail.hpp");
+            if (!f1 || !f2 || !f3) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::graph_source;
+            f2 << examples::graph_header;
+            f3 << examples::graph_detail;
+        }
+
+        // Without the include graph, the functions listed in the headers are reported as unlisted
+        const modules::analyze::CodeParser standalone(temp_source);
+        if (standalone.get_unlisted_functions().empty()) {
+            throw std::runtime_error("Expected unlisted functions without the include graph.");
+        }
+        if (standalone.get_quoted_includes() != std::vector<std::string>{"graph.hpp"}) {
+            throw std::runtime_error("Expected exactly one quoted include: 'graph.hpp'.");
+        }
+
+        // With the include graph, the functions are inherited from the headers, including the transitively included one
+        modules::graph::IncludeGraph graph({source_dir, include_dir});
+        modules::analyze::CodeParser parser(temp_source);
+        parser.inherit_listed_functions(graph.get_inherited_functions(temp_source, parser));
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {};
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
+            throw std::runtime_error("Unlisted functions test failed.");
+        }
+
+        // Each header is parsed exactly once, even when asked again, and the source file is not kept
+        static_cast<void>(graph.get_inherited_functions(temp_source, parser));
+        if (graph.get_parsed_count() != 2) {
+            throw std::runtime_error(fmt::format("Expected 2 parsed files, got {}.", graph.get_parsed_count()));
+        }
+        if (!modules::graph::is_source_file(temp_source) || modules::graph::is_source_file(source_dir / "graph.hpp")) {
+            throw std::runtime_error("Source files were not told apart from headers.");
+        }
+
+        fmt::print("test_graph::inherited() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_graph::inherited() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_graph::paired()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a source file with its paired header, and a header that is only included transitively
+        const auto temp_source = temp_dir.get() / "graph.cpp";
+        const auto temp_header = temp_dir.get() / "graph.hpp";
+        std::filesystem::create_directories(temp_dir.get() / "lib");
+        {
+            std::ofstream f1(temp_source);
+            std::ofstream f2(temp_header);
+            std::ofstream f3(temp_dir.get() / "lib" / "detail.hpp");
+            if (!f1 || !f2 || !f3) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::graph_source;
+            f2 << examples::graph_header;
+            f3 << examples::graph_detail;
+        }
+
+        // Only source files are paired, headers are not
+        if (modules::graph::find_paired_header(temp_source) != temp_header || modules::graph::find_paired_header(temp_header).has_value()) {
+            throw std::runtime_error("Paired header was not found correctly.");
+        }
+
+        // Only the functions listed in the paired header are inherited, not the transitively included ones
+        modules::graph::IncludeGraph graph({});
+        modules::analyze::CodeParser parser(temp_source);
+        parser.inherit_listed_functions(graph.get_summary(*modules::graph::find_paired_header(temp_source))->listed_functions);
+        const std::vector<helpers::RenderedUnlistedFunction> expected_unlisted_functions = {
+            helpers::RenderedUnlistedFunction{7, "    const std::size_t size = count(text.c_str());", "std::size_t", "https://duckduckgo.com/?sites=cppreference.com&q=std%3A%3Asize_t&ia=web"},
+        };
+        if (!helpers::compare_and_print_unlisted_functions(parser, expected_unlisted_functions)) {
+            throw std::runtime_error("Unlisted functions test failed.");
+        }
+
+        // Only the paired header was parsed and kept
+        if (graph.get_parsed_count() != 1) {
+            throw std::runtime_error(fmt::format("Expected 1 parsed file, got {}.", graph.get_parsed_count()));
+        }
+
+        fmt::print("test_graph::paired() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_graph::paired() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_fix::rewrite()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create temporary files
+        const auto temp_unused = temp_dir.get() / "unused.cpp";
+        const auto temp_fixable = temp_dir.get() / "fixable.cpp";
+        {
+            std::ofstream f1(temp_unused);
+            std::ofstream f2(temp_fixable);
+            if (!f1 || !f2) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::unused;
+            f2 << examples::fixable;
+        }
+
+        // Unused functions are removed, comments without names are dropped, and all other lines are kept as they are
+        const std::string expected_unused = "  #include<string>\n"
+                                            "#INCLUDE <IOSTREAM>      //     STD::COUT\n"
+                                            "#INCLUDE <vector>\n"
+                                            "#include <ALGORITHM>\n"
+                                            "#include <cstddef>        // for std::size_t\n"
+                                            "\n"
+                                            "const std::size_t pi = 3.14159;\n"
+                                            "std::cout << \"Hello world!\\n\";";
+        const std::string actual_unused = modules::fix::fix_text(std::string(examples::unused), modules::analyze::CodeParser(temp_unused), {true, true, false});
+        if (actual_unused != expected_unused) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_unused, actual_unused);
+            throw std::runtime_error("Unused functions were not fixed correctly.");
+        }
+
+        // Unlisted functions are appended to the include that provides them, unless the header is not included at all (e.g., "std::string")
+        const std::string expected_fixable = "#include <algorithm>  // for std::sort\n"
+                                             "#include <cstddef>  // for std::size_t\n"
+                                             "#include <vector>    // for std::vector\n"
+                                             "\n"
+                                             "std::vector<int> v = {3, 1, 2};\n"
+                                             "std::sort(v.begin(), v.end());\n"
+                                             "const std::size_t size = v.size();\n"
+                                             "const std::string name = \"fixable\";\n";
+        // The file is fixed through a symbolic link, which is kept, the file keeps its permissions, and an unrelated ".tmp" file next to it is not overwritten
+        const auto temp_link = temp_dir.get() / "link.cpp";
+        const auto unrelated_tmp = temp_dir.get() / "fixable.cpp.tmp";
+        const auto permissions = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write | std::filesystem::perms::group_read;
+        std::filesystem::create_symlink(temp_fixable, temp_link);
+        std::filesystem::permissions(temp_fixable, permissions);
+        {
+            std::ofstream f(unrelated_tmp);
+            if (!f) {
+                throw std::runtime_error("Failed to open unrelated_tmp for writing");
+            }
+            f << "unrelated";
+        }
+        if (!modules::fix::fix_file(temp_link, modules::analyze::CodeParser(temp_link), {true, true, false})) {
+            throw std::runtime_error("Expected the file to be rewritten.");
+        }
+        const std::string actual_fixable = core::io::read_text(temp_fixable);
+        if (actual_fixable != expected_fixable) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_fixable, actual_fixable);
+            throw std::runtime_error("Unlisted functions were not fixed correctly.");
+        }
+        if (!std::filesystem::is_symlink(temp_link) || std::filesystem::status(temp_fixable).permissions() != permissions ||
+            core::io::read_text(unrelated_tmp) != "unrelated") {
+            throw std::runtime_error("Expected the link, the permissions and the unrelated file to be kept.");
+        }
+
+        // A fixed file is left untouched, and no temporary file is left behind
+        if (modules::fix::fix_file(temp_fixable, modules::analyze::CodeParser(temp_fixable), {true, true, false})) {
+            throw std::runtime_error("Expected the fixed file to be left untouched.");
+        }
+        const auto file_count = std::distance(std::filesystem::directory_iterator(temp_dir.get()), std::filesystem::directory_iterator());
+        if (file_count != 4) {
+            throw std::runtime_error(fmt::format("Expected 4 files, got {}, a temporary file was left behind.", file_count));
+        }
+
+        // Comments that do not list names are kept verbatim, only comments that list names are rewritten
+        const auto temp_prose = temp_dir.get() / "prose.cpp";
+        const std::string prose = "#include <algorithm>  // std::find is no longer needed here\n"
+                                  "#include <string>  // for std::string, std::find\n"
+                                  "#include <vector>  // std::vector is needed here\n"
+                                  "\n"
+                                  "std::vector<std::string> v = {std::to_string(1)};\n";
+        {
+            std::ofstream f(temp_prose);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_prose for writing");
+            }
+            f << prose;
+        }
+        const std::string expected_prose = "#include <algorithm>  // std::find is no longer needed here\n"
+                                           "#include <string>  // for std::string, std::to_string\n"
+                                           "#include <vector>  // std::vector is needed here\n"
+                                           "\n"
+                                           "std::vector<std::string> v = {std::to_string(1)};\n";
+        const std::string actual_prose = modules::fix::fix_text(prose, modules::analyze::CodeParser(temp_prose), {true, true, false});
+        if (actual_prose != expected_prose) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_prose, actual_prose);
+            throw std::runtime_error("Prose comments were not kept verbatim.");
+        }
+
+        fmt::print("test_fix::rewrite() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_fix::rewrite() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_fix::diff()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a temporary file
+        const auto temp_file = temp_dir.get() / "fixable.cpp";
+        {
+            std::ofstream f(temp_file);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_file for writing");
+            }
+            f << examples::fixable;
+        }
+
+        // Both changed lines share a hunk with 3 lines of context after them
+        const std::string text = core::io::read_text(temp_file);
+        const std::string fixed = modules::fix::fix_text(text, modules::analyze::CodeParser(temp_file), {true, true, false});
+        const std::string expected = "--- a/fixable.cpp\n"
+                                     "+++ b/fixable.cpp\n"
+                                     "@@ -1,5 +1,5 @@\n"
+                                     "-#include <algorithm>  // for std::find\n"
+                                     "-#include <cstddef>\n"
+                                     "+#include <algorithm>  // for std::sort\n"
+                                     "+#include <cstddef>  // for std::size_t\n"
+                                     " #include <vector>    // for std::vector\n"
+                                     " \n"
+                                     " std::vector<int> v = {3, 1, 2};\n";
+        const std::string actual = core::diff::unified_diff(text, fixed, "fixable.cpp");
+        if (actual != expected) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected, actual);
+            throw std::runtime_error("Unified diff does not match.");
+        }
+
+        // Separate changes get separate hunks, and a missing final line ending is marked
+        const std::string expected_hunks = "--- a/lines.txt\n"
+                                           "+++ b/lines.txt\n"
+                                           "@@ -1,1 +1,2 @@\n"
+                                           "+0\n"
+                                           " 1\n"
+                                           "@@ -8,2 +9,2 @@\n"
+                                           " 8\n"
+                                           "-9\n"
+                                           "\\ No newline at end of file\n"
+                                           "+9\n";
+        const std::string actual_hunks = core::diff::unified_diff("1\n2\n3\n4\n5\n6\n7\n8\n9", "0\n1\n2\n3\n4\n5\n6\n7\n8\n9\n", "lines.txt", 1);
+        if (actual_hunks != expected_hunks) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_hunks, actual_hunks);
+            throw std::runtime_error("Unified diff hunks do not match.");
+        }
+
+        // Rendering a diff leaves the file untouched
+        if (modules::fix::diff_file(temp_file, modules::analyze::CodeParser(temp_file), {true, true, false}).empty() ||
+            core::io::read_text(temp_file) != text) {
+            throw std::runtime_error("Expected a diff and an untouched file.");
+        }
+
+        fmt::print("test_fix::diff() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_fix::diff() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_fix::insert()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create temporary files, the second one has no include directives at all
+        const auto temp_missing = temp_dir.get() / "missing.hpp";
+        const auto temp_empty = temp_dir.get() / "empty.hpp";
+        const std::string empty = "#pragma once\n\nstd::string s;";
+        {
+            std::ofstream f1(temp_missing);
+            std::ofstream f2(temp_empty);
+            if (!f1 || !f2) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::missing_includes;
+            f2 << empty;
+        }
+
+        // Missing includes are inserted into the standard block at their sorted position, with aligned comments
+        const std::string expected_missing = "#pragma once\n"
+                                             "\n"
+                                             "#include <algorithm>  // for std::sort\n"
+                                             "#include <cstddef>  // for std::size_t\n"
+                                             "#include <iostream>  // for std::cout\n"
+                                             "#include <string>   // for std::string\n"
+                                             "#include <vector>   // for std::vector\n"
+                                             "\n"
+                                             "#include <fmt/core.h>\n"
+                                             "\n"
+                                             "std::vector<std::string> names;\n"
+                                             "std::sort(names.begin(), names.end());\n"
+                                             "const std::size_t count = names.size();\n"
+                                             "std::cout << count;\n";
+        const std::string actual_missing = modules::fix::fix_text(std::string(examples::missing_includes), modules::analyze::CodeParser(temp_missing), {true, true, true});
+        if (actual_missing != expected_missing) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_missing, actual_missing);
+            throw std::runtime_error("Missing includes were not inserted correctly.");
+        }
+
+        // Comments added to bare includes and inserted includes are aligned with the original comments of the block
+        const auto temp_aligned = temp_dir.get() / "aligned.hpp";
+        const std::string aligned = "#include <cstddef>    // for std::size_t\n"
+                                    "#include <string>\n"
+                                    "#include <vector>     // for std::vector\n"
+                                    "\n"
+                                    "std::vector<std::string> names;\n"
+                                    "const std::size_t count = names.size();\n"
+                                    "std::cout << count;\n";
+        {
+            std::ofstream f(temp_aligned);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_aligned for writing");
+            }
+            f << aligned;
+        }
+        const std::string expected_aligned = "#include <cstddef>    // for std::size_t\n"
+                                             "#include <iostream>   // for std::cout\n"
+                                             "#include <string>     // for std::string\n"
+                                             "#include <vector>     // for std::vector\n"
+                                             "\n"
+                                             "std::vector<std::string> names;\n"
+                                             "const std::size_t count = names.size();\n"
+                                             "std::cout << count;\n";
+        const std::string actual_aligned = modules::fix::fix_text(aligned, modules::analyze::CodeParser(temp_aligned), {true, true, true});
+        if (actual_aligned != expected_aligned) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_aligned, actual_aligned);
+            throw std::runtime_error("Comments were not aligned correctly.");
+        }
+
+        // Without any include directives, a new block is started after "#pragma once"
+        const std::string expected_empty = "#pragma once\n\n#include <string>  // for std::string\n\nstd::string s;";
+        const std::string actual_empty = modules::fix::fix_text(empty, modules::analyze::CodeParser(temp_empty), {true, true, true});
+        if (actual_empty != expected_empty) {
+            fmt::print(stderr, "Expected:\n{}\nGot:\n{}\n", expected_empty, actual_empty);
+            throw std::runtime_error("Missing include was not inserted correctly.");
+        }
+
+        // Insertion is opt-in
+        if (modules::fix::fix_text(empty, modules::analyze::CodeParser(temp_empty), {true, true, false}) != empty) {
+            throw std::runtime_error("Expected no changes without insertion.");
+        }
+
+        fmt::print("test_fix::insert() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_fix::insert() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_index::query()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Two files that use and list different functions
+        const auto temp_file1 = temp_dir.get() / "unused.cpp";
+        const auto temp_file2 = temp_dir.get() / "unlisted.cpp";
+        {
+            std::ofstream f1(temp_file1);
+            std::ofstream f2(temp_file2);
+            if (!f1 || !f2) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::unused;
+            f2 << examples::unlisted;
+        }
+
+        // Run the app with "--index", which writes the index after the analysis
+        const auto index_path = temp_dir.get() / "header-warden.idx";
+        const std::string temp_dir_str = temp_dir.get().string();
+        const std::string index_path_str = index_path.string();
+        std::vector<char> temp_dir_cstr(temp_dir_str.cbegin(), temp_dir_str.cend());
+        std::vector<char> index_path_cstr(index_path_str.cbegin(), index_path_str.cend());
+        temp_dir_cstr.emplace_back('\0');  // Ensure null-termination
+        index_path_cstr.emplace_back('\0');
+        char test_executable_name[] = TEST_EXECUTABLE_NAME;
+        char arg_index[] = "--index";
+        char *fake_argv[] = {test_executable_name, temp_dir_cstr.data(), arg_index, index_path_cstr.data()};
+        app::run(core::args::Args(4, fake_argv));
+
+        // In diff mode, the index is written as well, but only the patch is printed to the output
+        char arg_diff[] = "--diff";
+        char *fake_diff_argv[] = {test_executable_name, temp_dir_cstr.data(), arg_index, index_path_cstr.data(), arg_diff};
+        const std::string diff_output = helpers::run_and_capture(core::args::Args(5, fake_diff_argv), temp_dir.get() / "diff.txt");
+        if (diff_output.find("Symbol index written to") != std::string::npos || !std::filesystem::exists(index_path)) {
+            throw std::runtime_error("Expected the index to be written without printing its path into the patch.");
+        }
+
+        // Parse a query the same way as the command line, the function is normalized to lowercase with the "std::" prefix
+        char arg_query[] = "query";
+        char arg_function[] = "COUT";
+        char *fake_query_argv[] = {test_executable_name, arg_query, arg_function, arg_index, index_path_cstr.data()};
+        const core::args::Args query_args(5, fake_query_argv);
+        if (!query_args.query || query_args.query->function != "std::cout" || query_args.query->index_path != index_path) {
+            throw std::runtime_error("Query arguments were not parsed correctly.");
+        }
+
+        // Look up the function, hits are sorted by file and line
+        const modules::index::IndexReader reader(index_path);
+        const auto hits = reader.find(query_args.query->function);
+        const std::vector<std::tuple<std::string, std::uint32_t, modules::analyze::Occurrence::Kind>> expected = {
+            {temp_file2.string(), 1, modules::analyze::Occurrence::Kind::Listed},
+            {temp_file2.string(), 5, modules::analyze::Occurrence::Kind::Used},
+            {temp_file1.string(), 2, modules::analyze::Occurrence::Kind::Listed},
+            {temp_file1.string(), 8, modules::analyze::Occurrence::Kind::Used},
+        };
+        std::vector<std::tuple<std::string, std::uint32_t, modules::analyze::Occurrence::Kind>> actual;
+        for (const auto &hit : hits) {
+            actual.emplace_back(std::string(hit.file), hit.number, hit.kind);
+        }
+        if (actual != expected) {
+            for (const auto &[file, number, kind] : actual) {
+                fmt::print(stderr, "  Hit: '{}:{}' ({})\n", file, number, kind == modules::analyze::Occurrence::Kind::Used ? "used" : "listed");
+            }
+            throw std::runtime_error("Unexpected hits for 'std::cout'.");
+        }
+
+        // Unknown functions have no hits
+        if (!reader.find("std::regex").empty() || reader.get_file_count() != 2) {
+            throw std::runtime_error("Expected no hits for 'std::regex' and 2 indexed files.");
+        }
+
+        // A missing index is reported like any other index error
+        try {
+            const modules::index::IndexReader missing(temp_dir.get() / "missing.idx");
+            throw std::runtime_error("Loading a missing index succeeded.");
+        }
+        catch (const std::runtime_error &e) {
+            if (std::string_view(e.what()).rfind("Error loading index", 0) != 0) {
+                throw;
+            }
+        }
+
+        // Corrupted counts are rejected on load, corrupted strings and postings when a query reads them, so that queries never read outside of the mapping
+        std::string bytes;
+        {
+            std::ifstream f(index_path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        }
+        std::uint64_t function_count = 0;
+        std::uint64_t posting_count = 0;
+        std::memcpy(&function_count, bytes.data() + 16, sizeof(function_count));
+        std::memcpy(&posting_count, bytes.data() + 24, sizeof(posting_count));
+
+        // Find the record and the first posting of "std::cout" by scanning the function table
+        const std::size_t functions_offset = 40 + 2 * 16;
+        const std::size_t postings_offset = functions_offset + function_count * 32;
+        const std::size_t strings_offset = postings_offset + posting_count * 12;
+        std::size_t cout_record_offset = 0;
+        std::size_t cout_posting_offset = 0;
+        for (std::size_t i = 0; i < function_count; ++i) {
+            std::array<std::uint64_t, 4> record{};  // Name offset, name length, first posting, posting count
+            std::memcpy(record.data(), bytes.data() + functions_offset + i * 32, sizeof(record));
+            if (bytes.compare(strings_offset + record[0], record[1], "std::cout") == 0) {
+                cout_record_offset = functions_offset + i * 32;
+                cout_posting_offset = postings_offset + record[2] * 12;
+            }
+        }
+        if (cout_posting_offset == 0) {
+            throw std::runtime_error("Expected 'std::cout' in the function table.");
+        }
+
+        const std::uint64_t overflowing_count = ~std::uint64_t{0} / 4;
+        const std::uint64_t huge_length = ~std::uint64_t{0};
+        const std::uint32_t missing_file = ~std::uint32_t{0};
+        const std::vector<std::tuple<std::size_t, const void *, std::size_t>> corruptions = {
+            {24, &overflowing_count, sizeof(overflowing_count)},           // Posting count that overflows the size arithmetic
+            {48, &huge_length, sizeof(huge_length)},                       // Length of the first file name, which has a hit for "std::cout"
+            {cout_record_offset + 24, &huge_length, sizeof(huge_length)},  // Posting count of "std::cout"
+            {cout_posting_offset, &missing_file, sizeof(missing_file)},    // File of the first posting of "std::cout"
+        };
+        const auto corrupted_path = temp_dir.get() / "corrupted.idx";
+        for (const auto &[offset, value, value_size] : corruptions) {
+            std::string corrupted = bytes;
+            std::memcpy(corrupted.data() + offset, value, value_size);
+            {
+                std::ofstream f(corrupted_path, std::ios::binary | std::ios::trunc);
+                f.write(corrupted.data(), static_cast<std::streamsize>(corrupted.size()));
+            }
+            try {
+                const modules::index::IndexReader corrupted_reader(corrupted_path);
+                static_cast<void>(corrupted_reader.find("std::cout"));
+                throw std::runtime_error(fmt::format("Querying an index corrupted at byte {} succeeded.", offset));
+            }
+            catch (const std::runtime_error &e) {
+                if (std::string_view(e.what()).rfind("Error loading index", 0) != 0) {
+                    throw;
+                }
+            }
+        }
+
+        fmt::print("test_index::query() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_index::query() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_aggregate::top()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create temporary files
+        const auto temp_unlisted = temp_dir.get() / "unlisted.cpp";
+        const auto temp_unused = temp_dir.get() / "unused.cpp";
+        const auto temp_badly_formatted = temp_dir.get() / "badly_formatted.cpp";
+        {
+            std::ofstream f1(temp_unlisted);
+            std::ofstream f2(temp_unused);
+            std::ofstream f3(temp_badly_formatted);
+            if (!f1 || !f2 || !f3) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::unlisted;
+            f2 << examples::unused;
+            f3 << examples::badly_formatted;
+        }
+
+        // Count the findings in two shards, as if they were added by two threads
+        modules::aggregate::SymbolCounter counter(2);
+        counter.add(0, modules::analyze::CodeParser(temp_unlisted));
+        counter.add(1, modules::analyze::CodeParser(temp_unlisted));
+        counter.add(1, modules::analyze::CodeParser(temp_unused));
+        counter.add(0, modules::analyze::CodeParser(temp_badly_formatted));
+
+        // Compare the merged results, ties are broken by name
+        const auto to_string = [](const std::vector<modules::aggregate::Count> &counts) {
+            std::vector<std::string> result;
+            for (const auto &count : counts) {
+                result.emplace_back(fmt::format("{}={}/{}", count.function, count.occurrences, count.files));
+            }
+            return result;
+        };
+        const std::vector<std::string> expected_unlisted = {"std::sort=3/3", "std::size_t=2/2"};
+        const std::vector<std::string> expected_unused = {"std::back_inserter=2/2", "std::find=2/2", "std::transform=2/2"};
+        const auto actual_unlisted = to_string(counter.get_top_unlisted(10));
+        const auto actual_unused = to_string(counter.get_top_unused(3));
+        if (actual_unlisted != expected_unlisted || actual_unused != expected_unused) {
+            fmt::print(stderr, "Expected unlisted: '{}', got: '{}'\n", fmt::join(expected_unlisted, ", "), fmt::join(actual_unlisted, ", "));
+            fmt::print(stderr, "Expected unused: '{}', got: '{}'\n", fmt::join(expected_unused, ", "), fmt::join(actual_unused, ", "));
+            throw std::runtime_error("Aggregated counts do not match.");
+        }
+
+        // In diff mode, the tables are printed to stderr, so that only the patch is printed to the output
+        const std::string temp_dir_str = temp_dir.get().string();
+        std::vector<char> temp_dir_cstr(temp_dir_str.cbegin(), temp_dir_str.cend());
+        temp_dir_cstr.emplace_back('\0');  // Ensure null-termination
+        char test_executable_name[] = TEST_EXECUTABLE_NAME;
+        char arg_stats_symbols[] = "--stats-symbols";
+        char arg_count[] = "3";
+        char arg_diff[] = "--diff";
+        char *fake_argv[] = {test_executable_name, temp_dir_cstr.data(), arg_stats_symbols, arg_count, arg_diff};
+        const std::string diff_output = helpers::run_and_capture(core::args::Args(5, fake_argv), temp_dir.get() / "diff.txt");
+        if (diff_output.find("-- TOP") != std::string::npos) {
+            throw std::runtime_error("Expected the top functions to be kept out of the patch.");
+        }
+
+        fmt::print("test_aggregate::top() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_aggregate::top() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_stats::collect()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a temporary file, with a trailing newline, so that every line is terminated
+        const auto temp_file = temp_dir.get() / "no_issues.cpp";
+        {
+            std::ofstream f(temp_file, std::ios::binary);
+            if (!f) {
+                throw std::runtime_error("Failed to open temp_file for writing");
+            }
+            f << examples::no_issues << '\n';
+        }
+
+        // Parse the file and count synthetic files with known times, "file_0" is the fastest
+        core::stats::set_enabled(true);
+        core::stats::reset();
+        {
+            const modules::analyze::CodeParser parser(temp_file);
+        }
+        for (std::size_t i = 0; i < 15; ++i) {
+            core::stats::add_file(fmt::format("file_{}", i), std::chrono::nanoseconds(i));
+        }
+        const auto summary = core::stats::collect();
+        core::stats::set_enabled(false);
+
+        // Reading is nested in parsing, so both phases must be charged, but nothing else
+        const auto phase = [&summary](const core::stats::Phase p) {
+            return summary.phases[static_cast<std::size_t>(p)].count();
+        };
+        if (phase(core::stats::Phase::Read) <= 0 || phase(core::stats::Phase::Parse) <= 0 || phase(core::stats::Phase::Traverse) != 0 || phase(core::stats::Phase::Report) != 0) {
+            throw std::runtime_error("Phases were not charged as expected.");
+        }
+
+        // The parser allocates, so builds that track allocations must have counted some in its phase
+        if (core::stats::alloc_tracking && summary.allocations[static_cast<std::size_t>(core::stats::Phase::Parse)] == 0) {
+            throw std::runtime_error("No allocations were counted in the parse phase.");
+        }
+
+        // Hardware counters are not available on every machine, but if they are, the parser must have spent cycles, otherwise there must be a reason
+        const auto cycles = summary.events[static_cast<std::size_t>(core::stats::Phase::Parse)].values[static_cast<std::size_t>(core::perf::Event::Cycles)];
+        if (summary.counters_error.empty() ? cycles == 0 : cycles != 0) {
+            throw std::runtime_error(fmt::format("Hardware counters are inconsistent: {} cycles, error: '{}'", cycles, summary.counters_error));
+        }
+
+        // The peak resident set size is not available on every platform, but it cannot be zero if it is
+        if (const auto peak_rss = core::stats::get_peak_rss(); peak_rss && *peak_rss == 0) {
+            throw std::runtime_error("Peak RSS is zero.");
+        }
+
+        // Every line, including its newline, is counted as read
+        if (summary.files != 15 || summary.bytes != examples::no_issues.size() + 1 || summary.busy.size() != 1) {
+            throw std::runtime_error(fmt::format("Expected 15 files, {} bytes and 1 busy thread, got: {} files, {} bytes and {} busy threads.",
+                                                 examples::no_issues.size() + 1, summary.files, summary.bytes, summary.busy.size()));
+        }
+
+        // Latencies below 32 ns are exact, so the percentiles of 0 to 14 ns are known, e.g., p50 is the 8th latency
+        const auto percentile = [&summary](const double p) { return summary.latency.get_percentile(p).count(); };
+        if (summary.latency.get_count() != 15 || percentile(50.0) != 7 || percentile(90.0) != 13 || percentile(99.0) != 14 || summary.latency.get_max().count() != 14) {
+            throw std::runtime_error(fmt::format("Expected 15 latencies with p50 7 ns, p90 13 ns, p99 14 ns and max 14 ns, got: {} latencies with p50 {} ns, p90 {} ns, p99 {} ns and max {} ns.",
+                                                 summary.latency.get_count(), percentile(50.0), percentile(90.0), percentile(99.0), summary.latency.get_max().count()));
+        }
+
+        // Larger latencies are bucketed, but within about 3%
+        core::stats::Histogram histogram;
+        histogram.record(std::chrono::milliseconds(1));
+        histogram.record(std::chrono::seconds(1));
+        const auto p50 = histogram.get_percentile(50.0).count();
+        if (p50 < 1'000'000 || p50 > 1'031'250 || histogram.get_percentile(99.9) != std::chrono::seconds(1)) {
+            throw std::runtime_error(fmt::format("Bucketed percentiles are off: p50 {} ns, p99.9 {} ns.", p50, histogram.get_percentile(99.9).count()));
+        }
+
+        // Only the 10 slowest files are kept, slowest first
+        std::vector<std::string> slowest;
+        for (const auto &file : summary.slowest) {
+            slowest.emplace_back(file.path);
+        }
+        const std::vector<std::string> expected_slowest = {"file_14", "file_13", "file_12", "file_11", "file_10", "file_9", "file_8", "file_7", "file_6", "file_5"};
+        if (slowest != expected_slowest) {
+            throw std::runtime_error(fmt::format("Expected slowest files: '{}', got: '{}'", fmt::join(expected_slowest, ", "), fmt::join(slowest, ", ")));
+        }
+
+        fmt::print("test_stats::collect() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_stats::collect() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_stats::trace()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+        const auto trace_file = temp_dir.get() / "trace.json";
+
+        // Record nested spans on this thread and a span for a file with a quote in its name on another thread
+        const std::filesystem::path quoted_path = "dir/\"quoted\".cpp";
+        core::trace::set_enabled(true);
+        core::trace::reset();
+        {
+            const core::trace::ScopedSpan outer("outer");
+            const core::trace::ScopedSpan inner("inner");
+        }
+        std::thread worker([&quoted_path] {
+            const core::trace::ScopedSpan file_span("file", quoted_path);
+        });
+        worker.join();
+        core::trace::write(trace_file);
+        core::trace::set_enabled(false);
+
+        // Every span is a complete event on its thread's track, the path is escaped
+        const std::string json = core::io::read_text(trace_file);
+        const std::vector<std::string> expected_parts = {
+            R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"thread 1"}})",
+            R"({"name":"inner","cat":"header-warden","ph":"X","pid":1,"tid":1,"ts":)",
+            R"({"name":"outer","cat":"header-warden","ph":"X","pid":1,"tid":1,"ts":)",
+            R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"thread 2"}})",
+            R"("args":{"path":"dir/\"quoted\".cpp"}})",
+        };
+        for (const auto &part : expected_parts) {
+            if (json.find(part) == std::string::npos) {
+                throw std::runtime_error(fmt::format("Expected '{}' in trace: {}", part, json));
+            }
+        }
+
+        fmt::print("test_stats::trace() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_stats::trace() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
 int test_app::paths()
 {
     try {
@@ -532,3 +1549,121 @@ int test_app::paths()
         return EXIT_FAILURE;
     }
 }
+
+int test_app::discover()
+{
+    try {
+        // Create a temporary directory using RAII
+        const helpers::TempDir temp_dir(std::filesystem::temp_directory_path() / TEST_EXECUTABLE_NAME);
+
+        // Create a source file, its header, and a header found only through an include directory, as in test_graph::inherited()
+        const auto source_dir = temp_dir.get() / "src";
+        const auto include_dir = temp_dir.get() / "include";
+        std::filesystem::create_directories(source_dir);
+        std::filesystem::create_directories(include_dir / "lib");
+        {
+            std::ofstream f1(source_dir / "graph.cpp");
+            std::ofstream f2(source_dir / "graph.hpp");
+            std::ofstream f3(include_dir / "lib" / "detail.hpp");
+            if (!f1 || !f2 || !f3) {
+                throw std::runtime_error("Failed to open temp files for writing");
+            }
+            f1 << examples::graph_source;
+            f2 << examples::graph_header;
+            f3 << examples::graph_detail;
+        }
+
+        // Write a compilation database that lists only the source file, so that both headers are discovered
+        const auto database = temp_dir.get() / "compile_commands.json";
+        {
+            std::ofstream f(database);
+            if (!f) {
+                throw std::runtime_error("Failed to open database for writing");
+            }
+            f << "[{\"directory\": \"" << temp_dir.get().generic_string() << "\", \"command\": \"c++ -Isrc -Iinclude -c src/graph.cpp\", \"file\": \"src/graph.cpp\"}]\n";
+        }
+
+        // Build the argv array with mutable strings
+        char test_executable_name[] = TEST_EXECUTABLE_NAME;
+        char arg_compile_commands[] = "--compile-commands";
+        char arg_stats[] = "--stats";
+        const std::string database_str = database.string();
+        std::vector<char> database_cstr(database_str.cbegin(), database_str.cend());
+        database_cstr.emplace_back('\0');  // Ensure null-termination
+        char *fake_argv[] = {test_executable_name, arg_compile_commands, database_cstr.data(), arg_stats};
+        app::run(core::args::Args(4, fake_argv));
+
+        // The headers parsed by the include graph are analyzed with the same parse, so each file is parsed exactly once
+        const core::stats::Summary summary = core::stats::collect();
+        core::stats::set_enabled(false);
+        const std::size_t parse_count = summary.entries[static_cast<std::size_t>(core::stats::Phase::Parse)];
+        if (summary.files != 3 || parse_count != 3) {
+            throw std::runtime_error(fmt::format("Expected 3 files parsed once each, got {} files parsed {} times.", summary.files, parse_count));
+        }
+
+        fmt::print("test_app::discover() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_app::discover() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
+
+int test_app::channel()
+{
+    try {
+        // Items that were pushed before closing are still popped, in order, but further pushes are rejected
+        core::channel::Channel<int> closed(4);
+        if (!closed.push(1) || !closed.push(2)) {
+            throw std::runtime_error("Pushing into an open channel failed.");
+        }
+        closed.close();
+        if (closed.push(3)) {
+            throw std::runtime_error("Pushing into a closed channel succeeded.");
+        }
+        const auto first = closed.pop();
+        const auto second = closed.pop();
+        if (!first || *first != 1 || !second || *second != 2 || closed.pop()) {
+            throw std::runtime_error("Popping from a closed channel did not drain it in order.");
+        }
+
+        // A producer that is far ahead of the consumers waits for them, the capacity is smaller than the number of items on purpose
+        constexpr int item_count = 1000;
+        core::channel::Channel<int> bounded(2);
+        std::vector<long long> sums(3, 0);
+        std::vector<std::thread> consumers;
+        for (std::size_t i = 0; i < sums.size(); ++i) {
+            consumers.emplace_back([&bounded, &sums, i]() {
+                while (const auto item = bounded.pop()) {
+                    sums[i] += *item;
+                }
+            });
+        }
+        for (int i = 1; i <= item_count; ++i) {
+            if (!bounded.push(i)) {
+                throw std::runtime_error("Pushing into an open channel failed.");
+            }
+        }
+        bounded.close();
+        for (auto &consumer : consumers) {
+            consumer.join();
+        }
+
+        // Every item must have been consumed exactly once
+        long long total = 0;
+        for (const auto sum : sums) {
+            total += sum;
+        }
+        if (total != static_cast<long long>(item_count) * (item_count + 1) / 2) {
+            throw std::runtime_error(fmt::format("Expected a sum of {}, got {}.", static_cast<long long>(item_count) * (item_count + 1) / 2, total));
+        }
+
+        fmt::print("test_app::channel() passed.\n");
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "test_app::channel() failed: {}\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
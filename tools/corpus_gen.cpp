@@ -0,0 +1,507 @@
+/**
+ * @file corpus_gen.cpp
+ *
+ * @brief Generate a synthetic tree of C++ files to reproduce performance problems on large code bases.
+ */
+
+#include <algorithm>    // for std::clamp, std::min
+#include <array>        // for std::array
+#include <cmath>        // for std::cos, std::exp, std::log, std::sqrt
+#include <cstddef>      // for std::size_t
+#include <cstdint>      // for std::uint64_t
+#include <cstdlib>      // for EXIT_FAILURE, EXIT_SUCCESS
+#include <exception>    // for std::exception
+#include <filesystem>   // for std::filesystem
+#include <fstream>      // for std::ofstream
+#include <stdexcept>    // for std::runtime_error
+#include <string>       // for std::string, std::to_string
+#include <string_view>  // for std::string_view
+#include <vector>       // for std::vector
+
+#include <argparse/argparse.hpp>
+#include <fmt/core.h>
+
+#include "core/string.hpp"
+#include "version.hpp"
+
+#include "examples.hpp"
+
+namespace corpus_gen {
+
+/**
+ * @brief Struct that represents the parameters of the generated corpus.
+ */
+struct Options final {
+    /**
+     * @brief Directory to write the files to. It must not exist or be empty.
+     */
+    std::filesystem::path output;
+
+    /**
+     * @brief Number of files to write.
+     */
+    std::size_t files;
+
+    /**
+     * @brief Seed of the generator. The same seed and options always produce the same corpus.
+     */
+    std::uint64_t seed;
+
+    /**
+     * @brief If true, the number of lines per file is log-normally distributed, like in real code bases. Otherwise, it is uniformly distributed.
+     */
+    bool lognormal;
+
+    /**
+     * @brief Minimum number of lines per file.
+     */
+    std::size_t min_lines;
+
+    /**
+     * @brief Maximum number of lines per file.
+     */
+    std::size_t max_lines;
+
+    /**
+     * @brief Fraction of code lines that use standard functions, between 0 and 1.
+     */
+    double std_density;
+
+    /**
+     * @brief Fraction of include directives without listed functions, between 0 and 1.
+     */
+    double bare_ratio;
+
+    /**
+     * @brief Fraction of lines that are comments, between 0 and 1.
+     */
+    double comment_density;
+
+    /**
+     * @brief Maximum number of nested directories a file is placed in.
+     */
+    std::size_t depth;
+};
+
+/**
+ * @brief Class that represents a deterministic pseudo-random number generator, using SplitMix64.
+ *
+ * Unlike the standard distributions, the results are identical across standard library implementations, so a seed reproduces the same corpus on every platform.
+ *
+ * @note This class is marked as `final` to prevent inheritance.
+ */
+class Random final {
+  public:
+    /**
+     * @brief Construct a new Random object.
+     *
+     * @param seed Seed of the generator (e.g., "42").
+     */
+    explicit Random(const std::uint64_t seed)
+        : state_(seed) {}
+
+    /**
+     * @brief Get the next pseudo-random number.
+     *
+     * @return Number in the full range of a 64-bit integer (e.g., "13679457532755275413").
+     */
+    [[nodiscard]] std::uint64_t next()
+    {
+        std::uint64_t z = (this->state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Get the next pseudo-random number in a half-open range.
+     *
+     * @param bound Exclusive upper bound, must be positive (e.g., "10").
+     *
+     * @return Number between 0 and bound - 1 (e.g., "7").
+     */
+    [[nodiscard]] std::size_t below(const std::size_t bound)
+    {
+        return static_cast<std::size_t>(this->next() % bound);
+    }
+
+    /**
+     * @brief Get the next pseudo-random fraction.
+     *
+     * @return Number between 0 (inclusive) and 1 (exclusive), using the top 53 bits (e.g., "0.42").
+     */
+    [[nodiscard]] double uniform()
+    {
+        return static_cast<double>(this->next() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * @brief Decide whether an event with the given probability happens.
+     *
+     * @param probability Probability of the event, between 0 and 1 (e.g., "0.2").
+     *
+     * @return True with the given probability, false otherwise.
+     */
+    [[nodiscard]] bool chance(const double probability)
+    {
+        return this->uniform() < probability;
+    }
+
+  private:
+    /**
+     * @brief Current state of the generator.
+     */
+    std::uint64_t state_;
+};
+
+/**
+ * @brief Struct that represents the lines of the test examples, sorted into the building blocks of a file.
+ */
+struct BuildingBlocks final {
+    /**
+     * @brief Include directives with functions listed as comments (e.g., "#include <vector>     // for std::vector").
+     */
+    std::vector<std::string> listed_includes;
+
+    /**
+     * @brief Include directives without comments (e.g., "#include <vector>").
+     */
+    std::vector<std::string> bare_includes;
+
+    /**
+     * @brief Comment lines, including the inside of doxygen blocks (e.g., " * @brief Example of a badly formatted file.").
+     */
+    std::vector<std::string> comments;
+
+    /**
+     * @brief Code lines that use standard functions (e.g., "std::sort(v.begin(), v.end());").
+     */
+    std::vector<std::string> std_code;
+
+    /**
+     * @brief Code lines that do not use standard functions (e.g., "int main()").
+     */
+    std::vector<std::string> plain_code;
+};
+
+/**
+ * @brief Sort the lines of all test examples into building blocks.
+ *
+ * Listed include directives are also turned into bare ones by removing their comment, so that both kinds are available for any header.
+ *
+ * @return Building blocks, none of which are empty.
+ */
+[[nodiscard]] BuildingBlocks load_building_blocks()
+{
+    static constexpr std::array<std::string_view, 12> sources = {
+        examples::badly_formatted,
+        examples::no_issues,
+        examples::bare,
+        examples::unused,
+        examples::unlisted,
+        examples::fixable,
+        examples::missing_includes,
+        examples::redundant,
+        examples::misattributed,
+        examples::graph_header,
+        examples::graph_detail,
+        examples::graph_source,
+    };
+
+    BuildingBlocks blocks;
+    for (const auto source : sources) {
+        std::size_t begin = 0;
+        while (begin <= source.size()) {
+            const std::size_t end = std::min(source.find('\n', begin), source.size());
+            const std::string line(source.substr(begin, end - begin));
+            begin = end + 1;
+
+            const std::string stripped = core::string::strip_whitespace(line);
+            // Skip empty lines and preprocessor directives other than includes (e.g., "#pragma once"), since the analysis ignores them
+            if (stripped.empty() || (stripped[0] == '#' && core::string::to_lower(stripped).find("include") == std::string::npos)) {
+                continue;
+            }
+            // Include directives, only angle includes are used, since quoted includes would not resolve
+            if (stripped[0] == '#') {
+                if (stripped.find('<') == std::string::npos) {
+                    continue;
+                }
+                const std::string bare = core::string::strip_whitespace(core::string::remove_comment(stripped));
+                if (bare != stripped) {
+                    blocks.listed_includes.emplace_back(stripped);
+                }
+                blocks.bare_includes.emplace_back(bare);
+            }
+            else if (stripped.compare(0, 2, "//") == 0 || stripped.compare(0, 2, "/*") == 0 || stripped[0] == '*') {
+                blocks.comments.emplace_back(line);
+            }
+            else if (line.find("std::") != std::string::npos) {
+                blocks.std_code.emplace_back(line);
+            }
+            else {
+                blocks.plain_code.emplace_back(line);
+            }
+        }
+    }
+
+    // Error: The examples changed so much that a kind of line is missing
+    if (blocks.listed_includes.empty() || blocks.bare_includes.empty() || blocks.comments.empty() || blocks.std_code.empty() || blocks.plain_code.empty()) {
+        throw std::runtime_error("The test examples do not provide every kind of line");
+    }
+    return blocks;
+}
+
+/**
+ * @brief Pick a random line from a list of lines.
+ *
+ * @param random Generator to pick the line with.
+ * @param lines Lines to pick from, must not be empty.
+ *
+ * @return Const reference to the picked line.
+ */
+[[nodiscard]] const std::string &pick(Random &random,
+                                      const std::vector<std::string> &lines)
+{
+    return lines[random.below(lines.size())];
+}
+
+/**
+ * @brief Draw the number of lines of a file from the configured distribution.
+ *
+ * The log-normal distribution has its median at the geometric mean of the bounds and covers about 95% of the range within two standard deviations. Values outside the range are clamped.
+ *
+ * @param random Generator to draw the number with.
+ * @param options Options that define the distribution.
+ *
+ * @return Number of lines (e.g., "120").
+ */
+[[nodiscard]] std::size_t draw_line_count(Random &random,
+                                          const Options &options)
+{
+    const auto min_lines = static_cast<double>(options.min_lines);
+    const auto max_lines = static_cast<double>(options.max_lines);
+    double lines = 0.0;
+    if (options.lognormal) {
+        // Box-Muller transform, "1 - uniform()" avoids the logarithm of zero
+        const double normal = std::sqrt(-2.0 * std::log(1.0 - random.uniform())) * std::cos(6.283185307179586 * random.uniform());
+        const double mu = (std::log(min_lines) + std::log(max_lines)) / 2.0;
+        const double sigma = (std::log(max_lines) - std::log(min_lines)) / 4.0;
+        lines = std::exp(mu + sigma * normal);
+    }
+    else {
+        lines = min_lines + random.uniform() * (max_lines - min_lines + 1.0);
+    }
+    return static_cast<std::size_t>(std::clamp(lines, min_lines, max_lines));
+}
+
+/**
+ * @brief Generate the contents of a single file.
+ *
+ * The file starts with a block of include directives, roughly one per 50 lines, followed by comments and code lines in the configured ratios.
+ *
+ * @param random Generator to pick the lines with.
+ * @param blocks Building blocks to pick the lines from.
+ * @param options Options that define the ratios.
+ * @param line_count Number of lines in the file (e.g., "120").
+ *
+ * @return Contents of the file, each line terminated by a newline.
+ */
+[[nodiscard]] std::string generate_file(Random &random,
+                                        const BuildingBlocks &blocks,
+                                        const Options &options,
+                                        const std::size_t line_count)
+{
+    const std::size_t include_count = std::min<std::size_t>(1 + line_count / 50, std::min<std::size_t>(16, line_count));
+    std::string text;
+    for (std::size_t i = 0; i < include_count; ++i) {
+        text += random.chance(options.bare_ratio) ? pick(random, blocks.bare_includes) : pick(random, blocks.listed_includes);
+        text += '\n';
+    }
+    for (std::size_t i = include_count; i < line_count; ++i) {
+        if (random.chance(options.comment_density)) {
+            text += pick(random, blocks.comments);
+        }
+        else if (random.chance(options.std_density)) {
+            text += pick(random, blocks.std_code);
+        }
+        else {
+            text += pick(random, blocks.plain_code);
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+/**
+ * @brief Generate the corpus and write it to disk.
+ *
+ * @param options Options of the corpus.
+ *
+ * @throws std::runtime_error If the output directory is not empty or any file cannot be written.
+ */
+void run(const Options &options)
+{
+    // Error: Refuse to mix the corpus with existing files, which would make the results irreproducible
+    if (std::filesystem::exists(options.output) && !std::filesystem::is_empty(options.output)) {
+        throw std::runtime_error(fmt::format("Output directory is not empty: {}", options.output.string()));
+    }
+
+    const BuildingBlocks blocks = load_building_blocks();
+    Random random(options.seed);
+    std::size_t total_lines = 0;
+    std::size_t total_bytes = 0;
+    for (std::size_t i = 0; i < options.files; ++i) {
+        // Place the file in a random directory, up to the configured depth, with 4 directories per level (e.g., "dir_2/dir_0/file_17.cpp")
+        std::filesystem::path directory = options.output;
+        const std::size_t depth = random.below(options.depth + 1);
+        for (std::size_t level = 0; level < depth; ++level) {
+            directory /= "dir_" + std::to_string(random.below(4));
+        }
+        std::filesystem::create_directories(directory);
+
+        // Every fourth file is a header, roughly like in real code bases
+        const auto path = directory / ("file_" + std::to_string(i) + (random.below(4) == 0 ? ".hpp" : ".cpp"));
+        const std::size_t line_count = draw_line_count(random, options);
+        const std::string text = generate_file(random, blocks, options, line_count);
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file || !(file << text)) {
+            throw std::runtime_error(fmt::format("Failed to write file: {}", path.string()));
+        }
+        total_lines += line_count;
+        total_bytes += text.size();
+    }
+    fmt::print("Wrote {} files ({} lines, {} bytes) to '{}'.\n", options.files, total_lines, total_bytes, options.output.string());
+}
+
+/**
+ * @brief Parse the command-line arguments into options.
+ *
+ * @param argc Number of command-line arguments (e.g., "2").
+ * @param argv Array of command-line arguments (e.g., {"./corpus-gen", "corpus"}).
+ *
+ * @return Options of the corpus.
+ *
+ * @throws std::runtime_error If the arguments are invalid. The message includes the help.
+ */
+[[nodiscard]] Options parse_args(const int argc,
+                                 char **argv)
+{
+    argparse::ArgumentParser program("corpus-gen", PROJECT_VERSION);
+    program.set_usage_max_line_width(80);
+    program.add_description("Generate a synthetic tree of C++ files from the test examples, e.g., to benchmark header-warden on large code bases.");
+
+    program.add_argument("output")
+        .help("directory to write the files to, must not exist or be empty");
+
+    program.add_argument("--files")
+        .help("number of files to write")
+        .default_value(1000)
+        .scan<'i', int>();
+
+    program.add_argument("--seed")
+        .help("seed of the generator, the same seed and options always produce the same corpus")
+        .default_value(42)
+        .scan<'i', int>();
+
+    program.add_argument("--uniform")
+        .help("draws the number of lines per file uniformly, instead of log-normally")
+        .flag();
+
+    program.add_argument("--min-lines")
+        .help("minimum number of lines per file")
+        .default_value(10)
+        .scan<'i', int>();
+
+    program.add_argument("--max-lines")
+        .help("maximum number of lines per file")
+        .default_value(2000)
+        .scan<'i', int>();
+
+    program.add_argument("--std-density")
+        .help("fraction of code lines that use standard functions")
+        .default_value(0.5)
+        .scan<'g', double>();
+
+    program.add_argument("--bare-ratio")
+        .help("fraction of include directives without listed functions")
+        .default_value(0.2)
+        .scan<'g', double>();
+
+    program.add_argument("--comment-density")
+        .help("fraction of lines that are comments")
+        .default_value(0.2)
+        .scan<'g', double>();
+
+    program.add_argument("--depth")
+        .help("maximum number of nested directories a file is placed in")
+        .default_value(3)
+        .scan<'i', int>();
+
+    try {
+        program.parse_args(argc, argv);
+    }
+    catch (const std::exception &e) {
+        throw std::runtime_error(fmt::format("Error: {}\n\n{}", e.what(), program.help().str()));
+    }
+
+    const int files = program.get<int>("--files");
+    const int seed = program.get<int>("--seed");
+    const int min_lines = program.get<int>("--min-lines");
+    const int max_lines = program.get<int>("--max-lines");
+    const int depth = program.get<int>("--depth");
+    const double std_density = program.get<double>("--std-density");
+    const double bare_ratio = program.get<double>("--bare-ratio");
+    const double comment_density = program.get<double>("--comment-density");
+
+    // Throw if any count is out of range
+    if (files <= 0 || seed < 0 || min_lines <= 0 || max_lines < min_lines || depth < 0) {
+        throw std::runtime_error(fmt::format("Error: --files and --min-lines must be positive, --seed and --depth must not be negative, and --max-lines must not be less than --min-lines\n\n{}", program.help().str()));
+    }
+    // Throw if any fraction is out of range
+    for (const double fraction : {std_density, bare_ratio, comment_density}) {
+        if (fraction < 0.0 || fraction > 1.0) {
+            throw std::runtime_error(fmt::format("Error: Fractions must be between 0 and 1, got: {}\n\n{}", fraction, program.help().str()));
+        }
+    }
+
+    return Options{
+        std::filesystem::absolute(program.get<std::string>("output")).lexically_normal(),
+        static_cast<std::size_t>(files),
+        static_cast<std::uint64_t>(seed),
+        program["--uniform"] == false,
+        static_cast<std::size_t>(min_lines),
+        static_cast<std::size_t>(max_lines),
+        std_density,
+        bare_ratio,
+        comment_density,
+        static_cast<std::size_t>(depth),
+    };
+}
+
+}  // namespace corpus_gen
+
+/**
+ * @brief Entry-point of the corpus generator.
+ *
+ * @param argc Number of command-line arguments (e.g., "2").
+ * @param argv Array of command-line arguments (e.g., {"./corpus-gen", "corpus"}).
+ *
+ * @return EXIT_SUCCESS if the corpus was written successfully, EXIT_FAILURE otherwise.
+ */
+int main(int argc,
+         char **argv)
+{
+    try {
+        corpus_gen::run(corpus_gen::parse_args(argc, argv));
+    }
+    catch (const std::exception &e) {
+        fmt::print(stderr, "{}\n", e.what());
+        return EXIT_FAILURE;
+    }
+    catch (...) {
+        fmt::print(stderr, "Error: Unknown\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}